@@ -14,17 +14,9 @@ void CameraController::update()
     uint8_t playerX = player->getX();
     uint8_t playerY = player->getY();
    
-    if (playerX < MapConstants::ROOM_SIZE) {
-        cameraX = 0;  
-    } else {
-        cameraX = MapConstants::ROOM_SIZE;  
-    }
-    
-    if (playerY < MapConstants::ROOM_SIZE) {
-        cameraY = 0;  
-    } else {
-        cameraY = MapConstants::ROOM_SIZE;  
-    }
+    // Top-left corner of the room the player is in (any world size)
+    cameraX = playerX & ~(MapConstants::ROOM_SIZE - 1);
+    cameraY = playerY & ~(MapConstants::ROOM_SIZE - 1);
 
 }
 
@@ -57,6 +57,13 @@ namespace MatrixConstants
     constexpr byte BRIGHTNESS = 2;
     constexpr byte MAX_BRIGHTNESS = 15;
     constexpr byte DEVICE_COUNT = 1;
+    constexpr byte ROW_MSB = 0x80;  // column 0 of a row byte
+    constexpr byte OVERLAY_SLOTS = 2;
+}
+
+namespace OverlaySlots
+{
+    constexpr uint8_t EXPLOSIVE = 0;
 }
 
 namespace LCDConstants
@@ -64,6 +71,37 @@ namespace LCDConstants
     constexpr byte COLS = 16;
     constexpr byte ROWS = 2;
     constexpr byte SMALL_BUFFER_SIZE = 16;
+    constexpr byte DDRAM_COLS = 40;            // per row, visible or not
+    constexpr byte MARQUEE_HINT_PERIOD = 20;   // divides DDRAM_COLS, so the repeat wraps cleanly
+    // Custom glyphs are shown through codes 8-15, which the HD44780 maps to
+    // the same CGRAM slots as 0-7, so text never has to contain '\0'
+    constexpr byte GLYPH_CODE_BASE = 8;
+    
+    // LCDDisplay::update() drains changed cells until either limit is hit or
+    // the LCD is busy; the checks come before each transfer, so one may run over
+    constexpr uint16_t DRAIN_BUDGET_US = 500;
+    constexpr uint8_t MAX_TRANSFERS_PER_TICK = 8;
+}
+
+// In-game HUD (GameEngine::updateHud), numbers right-aligned in their fields,
+// each field preceded by its LCDGlyph icon (g gold, * score, f level,
+// h lives, x explosives):
+//   row 0  "gcc/tt    *sssss"
+//   row 1  "fll hl xee"
+namespace HudLayout
+{
+    constexpr uint8_t GOLD_COL = 1;
+    constexpr uint8_t GOLD_WIDTH = 2;
+    constexpr uint8_t TOTAL_GOLD_COL = 4;
+    constexpr uint8_t TOTAL_GOLD_WIDTH = 2;
+    constexpr uint8_t SCORE_COL = 11;
+    constexpr uint8_t SCORE_WIDTH = 5;
+    constexpr uint8_t LEVEL_COL = 1;
+    constexpr uint8_t LEVEL_WIDTH = 2;
+    constexpr uint8_t LIVES_COL = 5;
+    constexpr uint8_t LIVES_WIDTH = 1;
+    constexpr uint8_t EXPLOSIVES_COL = 8;
+    constexpr uint8_t EXPLOSIVES_WIDTH = 2;
 }
 
 namespace TimingConstants
@@ -127,7 +165,7 @@ namespace SoundDurationConstants
 namespace SystemDefaultConstants
 {
     constexpr uint8_t DEFAULT_LCD_BRIGHTNESS = 200;
-    constexpr uint8_t MAX_ATTEMPTS_BOMB_PLACEMENT = 100;
+    constexpr uint8_t MAX_BOMB_PLACEMENT_RETRIES = 8;
     constexpr uint8_t DEFAULT_MATRIX_BRIGHTNESS = 8;
     constexpr uint8_t MAX_LCD_BRIGHTNESS = 255;
     constexpr uint8_t PLAYER_NAME_LENGTH = 3;
@@ -176,8 +214,8 @@ namespace GameplayConstants
 {
     constexpr uint8_t TREASURE_DETECTION_RADIUS = 2;
     constexpr uint16_t LEVEL_COMPLETE_BONUS = 50;
-    constexpr uint8_t EXPLOSIVE_BLINK_CYCLE = 12;
-    constexpr uint8_t EXPLOSIVE_BLINK_ON_FRAMES = 6;
+    constexpr uint16_t EXPLOSIVE_BLINK_PERIOD_MS = 240;
+    constexpr uint16_t EXPLOSIVE_BLINK_ON_MS = 120;
     constexpr uint8_t EXPLOSION_PATTERN_SIZE = 5;
     constexpr uint16_t EXPLOSION_SOUND_DURATION_MS = 500;
     constexpr uint8_t GOLD_COLLECT_SCORE = 10;
@@ -200,17 +238,8 @@ namespace DifficultyConstants
     constexpr uint8_t EASY_LIVES = 4;
     constexpr uint8_t NORMAL_LIVES = 3;
     constexpr uint8_t HARD_LIVES = 2;
-    constexpr uint8_t LEVEL_0_BASE_BOMBS = 0;
-    constexpr uint8_t LEVEL_1_BASE_BOMBS = 4;
-    constexpr uint8_t LEVEL_2_BASE_BOMBS = 6;
-    constexpr uint8_t LEVEL_3_BASE_BOMBS = 8;
     constexpr uint8_t EASY_BOMB_REDUCTION = 1;
     constexpr uint8_t HARD_BOMB_INCREASE = 2;
-    constexpr uint8_t MIN_BOMBS_REDUCTION = 2;
-    constexpr float SCORE_MULT_LEVEL_0 = 1.0f;
-    constexpr float SCORE_MULT_LEVEL_1 = 1.5f;
-    constexpr float SCORE_MULT_LEVEL_2 = 2.0f;
-    constexpr float SCORE_MULT_LEVEL_3 = 3.0f;
     constexpr float SCORE_MULT_EASY = 0.8f;
     constexpr float SCORE_MULT_NORMAL = 1.0f;
     constexpr float SCORE_MULT_HARD = 1.5f;
@@ -228,6 +257,15 @@ namespace SerialConstants
     constexpr unsigned long BAUD_RATE = 115200;
 }
 
+namespace DebugConstants
+{
+    // Prints loop / matrix draw timings over Serial when enabled
+    constexpr bool PROFILE_LOOP = false;
+    constexpr uint16_t PROFILE_REPORT_INTERVAL_MS = 1000;
+    // Non-zero: every level load uses this seed for bombs and generated layouts
+    constexpr uint16_t FIXED_LEVEL_SEED = 0;
+}
+
 namespace JoystickConstants
 {
     constexpr byte DEADZONE = 30;
@@ -263,9 +301,18 @@ namespace BuzzerPins
 
 namespace MapConstants
 {
+    // Resident tile window: the whole world for 2x2-room levels
     constexpr byte WORLD_SIZE = 16;
     constexpr byte ROOM_SIZE = 8;
     constexpr byte ROOM_COUNT = 4;
+    constexpr byte ROOMS_PER_ROW = WORLD_SIZE / ROOM_SIZE;
+    
+    // Interior tiles off the border and room separators (12 x 12)
+    constexpr byte MAX_BOMB_CANDIDATES = (WORLD_SIZE - 4) * (WORLD_SIZE - 4);
+    
+    // Paged worlds (larger than 2x2 rooms)
+    constexpr byte MAX_ROOMS_PER_SIDE = 31;   // world coordinates stay below 256
+    constexpr byte DELTA_LOG_SIZE = 36;       // tile changes kept for paged-out rooms; levelc checks every level fits
     
     constexpr byte CAMERA_OFFSET_0 = 0;
     constexpr byte CAMERA_OFFSET_1 = 8;
@@ -274,8 +321,9 @@ namespace MapConstants
     constexpr byte LEVEL_1 = 1;  
     constexpr byte LEVEL_2 = 2;  
     constexpr byte LEVEL_3 = 3;  
+    constexpr byte LEVEL_COUNT = 6;   // entries in the level table (LevelData.h)
     constexpr byte MIN_LEVEL = 0;
-    constexpr byte MAX_LEVEL = 3;
+    constexpr byte MAX_LEVEL = LEVEL_COUNT - 1;
 }
 
 namespace SoundDurations
@@ -306,10 +354,13 @@ namespace DisplayConstants
 {
     constexpr uint8_t LCD_BUFFER_SIZE = 17;
     constexpr uint8_t DEFAULT_MATRIX_BRIGHTNESS = 8;
-    constexpr uint8_t GOLD_BLINK_CYCLE = 22;
-    constexpr uint8_t GOLD_BLINK_ON_FRAMES = 11;
-    constexpr uint8_t BOMB_BLINK_CYCLE = 8;
-    constexpr uint8_t BOMB_BLINK_ON_FRAMES = 4;
+    constexpr uint16_t GOLD_BLINK_PERIOD_MS = 440;
+    constexpr uint16_t GOLD_BLINK_ON_MS = 220;
+    constexpr uint16_t BOMB_BLINK_PERIOD_MS = 160;
+    constexpr uint16_t BOMB_BLINK_ON_MS = 80;
+    constexpr uint8_t TARGET_FPS = 30;
+    constexpr uint8_t RENDER_RESYNC_FRAMES = 8;
+    constexpr uint8_t ROOM_SCROLL_STEP = 2;  // columns/rows shifted per frame (4 frames per room)
 }
 
 namespace SpawnConstants
@@ -329,4 +380,46 @@ enum class TileType : uint8_t
     HIDDEN_GOLD = 6
 };
 
+// Compressed level layout, stored in PROGMEM. It starts with a table of
+// 16-bit little-endian offsets, one per room in row-major world order, so any
+// room can be decoded on its own. Each room record is:
+//   8 bytes   wall rows of the room (MSB = column 0)
+//   groups    group(type, count) followed by count positions (y << 3 | x)
+//   ROOM_END  terminates the room
+namespace LevelFormat
+{
+    constexpr uint8_t ROOM_END = 0x00;
+    constexpr uint8_t OFFSET_BYTES = 2;
+    constexpr uint8_t TYPE_SHIFT = 4;
+    constexpr uint8_t COUNT_MASK = 0x0F;
+    constexpr uint8_t MAX_GROUP_COUNT = 15;
+    constexpr uint8_t POS_Y_SHIFT = 3;
+    constexpr uint8_t POS_X_MASK = 0x07;
+    
+    constexpr uint8_t group(TileType type, uint8_t count)
+    {
+        return (static_cast<uint8_t>(type) << TYPE_SHIFT) | (count & COUNT_MASK);
+    }
+}
+
+// LevelDescriptor::flags
+namespace LevelFlags
+{
+    constexpr uint8_t NONE = 0x00;
+    constexpr uint8_t REFILL_EXPLOSIVES = 0x01;  // grant explosives even when not the starting level
+    constexpr uint8_t EXPLOSIVE_BONUS = 0x02;    // score bonus for unused explosives on completion
+    constexpr uint8_t PROCEDURAL = 0x04;         // no layout: Map::generateLayout builds one from the seed
+}
+
+// Map::generateLayout
+namespace ProceduralConstants
+{
+    constexpr uint8_t WALL_SEGMENTS_PER_ROOM = 3;
+    constexpr uint8_t MIN_SEGMENT_LENGTH = 1;
+    constexpr uint8_t MAX_SEGMENT_LENGTH = 3;
+    constexpr uint8_t GOLD_COUNT = 10;
+    constexpr uint8_t HIDDEN_GOLD_COUNT = 3;
+    constexpr uint8_t MAX_GENERATION_RETRIES = 4;  // then a layout without inner walls
+}
+
 #endif
@@ -0,0 +1,37 @@
+#ifndef FAST_RANDOM_H
+#define FAST_RANDOM_H
+
+#include <Arduino.h>
+
+// 16-bit xorshift PRNG (7, 9, 8). Only shifts and XORs, so it is cheap on
+// AVR where Arduino random() goes through 32-bit division. Same seed, same
+// sequence, which makes generated layouts reproducible.
+class FastRandom
+{
+private:
+    uint16_t state;
+    
+    static const uint16_t ZERO_SEED_REPLACEMENT = 0xACE1;  // xorshift state must be non-zero
+
+public:
+    explicit FastRandom(uint16_t seed)
+        : state{seed ? seed : ZERO_SEED_REPLACEMENT}
+    {
+    }
+    
+    uint16_t next()
+    {
+        state ^= state << 7;
+        state ^= state >> 9;
+        state ^= state << 8;
+        return state;
+    }
+    
+    // Value in [0, bound); multiply-shift instead of modulo, bound <= 255
+    uint8_t below(uint8_t bound)
+    {
+        return static_cast<uint8_t>((static_cast<uint16_t>(next() >> 8) * bound) >> 8);
+    }
+};
+
+#endif // FAST_RANDOM_H
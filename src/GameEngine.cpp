@@ -1,4 +1,6 @@
 #include "GameEngine.h"
+#include "Levels.h"
+#include "LCDFormatter.h"
 
 GameEngine::GameEngine(MatrixDisplay& matrix, LCDDisplay& lcd, Joystick& joy, Buzzer& buzz)
     : map()
@@ -21,20 +23,20 @@ GameEngine::GameEngine(MatrixDisplay& matrix, LCDDisplay& lcd, Joystick& joy, Bu
     , score(0)
     , explosivesUsedThisLevel(0)
     , lastUpdateTime(0)
-    , lastLCDUpdate(0)
     , lastMenuNavigationTime(0)
     , lastSettingsNavigationTime(0)
     , feedbackTimer(0)
     , messageDisplayStartTime(0)
     , waitingForMessageDisplay(false)
     , stateAfterMessage(GameState::MENU)
-    , aboutScrollOffset(0)
-    , lastAboutScrollTime(0)
-    , howToPlayScrollOffset(0)
-    , lastHowToPlayScrollTime(0)
+    , marquee(lcd)
     , lastCameraX(0)
     , lastCameraY(0)
+    , hudDirty(true)
+    , hudHoldStart(0)
+    , hudHoldMs(0)
 {
+    memset(hudValues, 0, sizeof(hudValues));
     editedName[0] = 'A';
     editedName[1] = 'A';
     editedName[2] = 'A';
@@ -59,7 +61,28 @@ void GameEngine::loadLevel(uint8_t levelIndex)
 {
     currentLevel = levelIndex;
     
-    map.loadLevel(levelIndex, &gameSettings);
+    if (DebugConstants::FIXED_LEVEL_SEED != 0) {
+        map.setLevelSeed(DebugConstants::FIXED_LEVEL_SEED);
+    } else {
+        map.setLevelSeed(static_cast<uint16_t>(micros()));
+    }
+    
+    // Explosives are settled first: bomb placement may only rely on
+    // blasting through walls if the player actually carries some
+    LevelDescriptor level;
+    getLevelDescriptor(levelIndex, level);
+    
+    if (levelIndex == gameSettings.getStartingLevel()) {
+        player.setExplosivesCount(level.explosives);
+    }
+    else if (level.flags & LevelFlags::REFILL_EXPLOSIVES) {
+        player.setExplosivesCount(level.explosives);
+    }
+    
+    map.loadLevel(levelIndex, &gameSettings, player.getExplosivesCount());
+    if (DebugConstants::PROFILE_LOOP) {
+        map.printDebug();
+    }
     
     player.resetGold();
     
@@ -69,30 +92,23 @@ void GameEngine::loadLevel(uint8_t levelIndex)
     }
     
     explosivesUsedThisLevel = 0;
-    //    
-    if (levelIndex == gameSettings.getStartingLevel()) {
-        if (levelIndex == MapConstants::LEVEL_2 || levelIndex == MapConstants::LEVEL_3) {
-            player.resetExplosives();  
-        } else {
-            player.setExplosivesCount(0);
-        }
-    }
-    else if (levelIndex == MapConstants::LEVEL_2) {
-        player.resetExplosives();
-    }
     
-    player.setPosition(SpawnConstants::DEFAULT_SPAWN_X, SpawnConstants::DEFAULT_SPAWN_Y);
+    player.setPosition(map.getSpawnX(), map.getSpawnY());
     
     activeExplosive.deactivate();
     explosivePlacedTime = 0;
+    matrixDisplay.clearOverlay(OverlaySlots::EXPLOSIVE);
     
     camera.update();
     
     playSound(ToneFrequencies::LEVEL_LOAD_HZ, SoundDurations::LEVEL_LOAD_TONE_MS);
     
     lcdDisplay.clear();
+    LCDFormatter levelNumber;
+    levelNumber.number(levelIndex + 1);
     lcdDisplay.printAt(0, 0, "Level ");
-    lcdDisplay.printAt(LCDConstants::COLS / 2 - 1, 0, String(levelIndex + 1).c_str());
+    lcdDisplay.printAt(LCDConstants::COLS / 2 - 1, 0, levelNumber.c_str());
+    holdHud(LEVEL_BANNER_MS);
 }
 
 void GameEngine::update()
@@ -167,14 +183,10 @@ void GameEngine::update()
                 showHighscores();
             }
             else if (menuOption == MenuIndexConstants::MENU_ABOUT) {
-                aboutScrollOffset = 0;
-                lastAboutScrollTime = currentTime;
                 gameState = GameState::ABOUT;
                 showAbout();
             }
             else if (menuOption == MenuIndexConstants::MENU_HOW_TO_PLAY) {
-                howToPlayScrollOffset = 0;
-                lastHowToPlayScrollTime = currentTime;
                 gameState = GameState::HOW_TO_PLAY;
                 showHowToPlay();
             }
@@ -184,17 +196,10 @@ void GameEngine::update()
     
     if (gameState == GameState::ABOUT)
     {
-    if (currentTime - lastAboutScrollTime < TimingConstants::TEXT_SCROLL_START_DELAY_MS && aboutScrollOffset == 0) {
-            // Wait before starting scroll
-        }
-    else if (currentTime - lastAboutScrollTime >= TimingConstants::TEXT_SCROLL_INTERVAL_MS) {
-            aboutScrollOffset++;
-            showAbout();
-            lastAboutScrollTime = currentTime;
-        }
+    marquee.update(currentTime);
         
     if (joystick.wasButtonPressed() || exitButton.wasPressed()) {
-            aboutScrollOffset = 0;
+            marquee.stop();
             gameState = GameState::MENU;
             menuOption = 0;
             showMenu();
@@ -204,17 +209,10 @@ void GameEngine::update()
     
     if (gameState == GameState::HOW_TO_PLAY)
     {
-    if (currentTime - lastHowToPlayScrollTime < TimingConstants::TEXT_SCROLL_START_DELAY_MS && howToPlayScrollOffset == 0) {
-            // Wait before starting scroll
-        }
-    else if (currentTime - lastHowToPlayScrollTime >= TimingConstants::TEXT_SCROLL_INTERVAL_MS) {
-            howToPlayScrollOffset++;
-            showHowToPlay();
-            lastHowToPlayScrollTime = currentTime;
-        }
+    marquee.update(currentTime);
         
     if (joystick.wasButtonPressed() || exitButton.wasPressed()) {
-            howToPlayScrollOffset = 0;
+            marquee.stop();
             gameState = GameState::MENU;
             menuOption = 0;
             showMenu();
@@ -304,7 +302,7 @@ void GameEngine::update()
     else if (dir == JoystickDirection::RIGHT && canNavigate) {
             switch (settingsOption) {
                 case MenuIndexConstants::SETTINGS_STARTING_LEVEL: // Starting Level
-                    if (gameSettings.getStartingLevel() < 3) {
+                    if (gameSettings.getStartingLevel() < MapConstants::MAX_LEVEL) {
                         gameSettings.setStartingLevel(gameSettings.getStartingLevel() + 1);
                         showSettingsMenu();
                         playSound(SoundFrequencies::SETTINGS_CHANGE_HZ, SoundDurationConstants::SETTINGS_CHANGE_MS);
@@ -433,6 +431,7 @@ void GameEngine::update()
         lcdDisplay.clear();
         lcdDisplay.printCentered(0, "Reset Scores?");
         lcdDisplay.printCentered(1, "Press again");
+        lcdDisplay.flush();  // the loop below doesn't return to loop()
         playSound(SoundFrequencies::RESET_PROMPT_HZ, SoundDurationConstants::RESET_PROMPT_MS);
         
         while (joystick.isButtonPressed()) {
@@ -566,9 +565,10 @@ void GameEngine::update()
             else
             {
                 gameState = GameState::PLAYING;
+                holdHud(0);  // redraw over the bomb message
             }
         }
-    matrixDisplay.draw(map, player, camera);
+    renderFrame(currentTime);
     return;
     }
     
@@ -582,7 +582,7 @@ void GameEngine::update()
             matrixDisplay.clear();
             return;
         }
-    matrixDisplay.draw(map, player, camera);
+    renderFrame(currentTime);
     return;
     }
     
@@ -609,14 +609,14 @@ void GameEngine::update()
                 lcdDisplay.clear();
                 lcdDisplay.printCentered(0, "YOU WIN!");
                 
-                char finalScore[LCDConstants::SMALL_BUFFER_SIZE];
-                sprintf(finalScore, "Score: %d", score);
-                lcdDisplay.printCentered(1, finalScore);
+                LCDFormatter finalScore;
+                finalScore.text(F("Score: ")).number(score);
+                lcdDisplay.printCentered(1, finalScore.c_str());
                 
                 playSoundPattern(BuzzerPattern::GAME_WON, SoundDurations::GAME_WON_MS);
             }
         }
-    matrixDisplay.draw(map, player, camera);
+    renderFrame(currentTime);
     return;
     }
     
@@ -629,7 +629,7 @@ void GameEngine::update()
             lastCameraY = camera.getCameraY();
             gameState = GameState::PLAYING;
         }
-    matrixDisplay.draw(map, player, camera);
+    renderFrame(currentTime);
     return;
     }
     
@@ -658,10 +658,10 @@ void GameEngine::update()
                 lcdDisplay.clear();
                 lcdDisplay.printCentered(0, "NEW HIGHSCORE!");
                 
-                char scoreMsg[SystemDefaultConstants::LCD_BUFFER_SIZE];
+                LCDFormatter scoreMsg;
                 uint8_t position = highscoreManager.getHighscorePosition(score);
-                sprintf(scoreMsg, "Rank #%d: %d", position + 1, score);
-                lcdDisplay.printCentered(1, scoreMsg);
+                scoreMsg.text(F("Rank #")).number(position + 1).text(F(": ")).number(score);
+                lcdDisplay.printCentered(1, scoreMsg.c_str());
                 
                 playSoundPattern(BuzzerPattern::COLLECT_GOLD, TimingConstants::TREASURE_COLLECT_SOUND_MS);
                 feedbackTimer = currentTime;
@@ -677,7 +677,7 @@ void GameEngine::update()
             }
             return;
         }
-    matrixDisplay.draw(map, player, camera);
+    renderFrame(currentTime);
     return;
     }
     
@@ -687,6 +687,7 @@ void GameEngine::update()
     score = 0;
     activeExplosive.deactivate();
     explosivePlacedTime = 0;
+    matrixDisplay.clearOverlay(OverlaySlots::EXPLOSIVE);
     gameState = GameState::MENU;
     showMenu();
     matrixDisplay.clear();
@@ -722,39 +723,22 @@ void GameEngine::update()
         handleExplosion();
     }
     
-    if (currentTime - lastLCDUpdate >= LCD_UPDATE_INTERVAL)
-    {
-        lastLCDUpdate = currentTime;
-        
-        bool recentBombPlaced = (activeExplosive.isActive() && 
-                                 explosivePlacedTime != 0 && 
-                                 (currentTime - explosivePlacedTime < TimingConstants::BOMB_PLACED_LCD_DISPLAY_MS));
-        
-        if (!recentBombPlaced) {
-            updateLCD();
-        }
+    // Input, explosions or the exit may have switched to a message screen
+    if (gameState == GameState::PLAYING) {
+        updateHud();
     }
     
-    matrixDisplay.draw(map, player, camera);
-    
-    if (activeExplosive.isActive())
-    {
-        uint8_t ex = activeExplosive.getX();
-        uint8_t ey = activeExplosive.getY();
-        
-        uint8_t camX = camera.getCameraX();
-        uint8_t camY = camera.getCameraY();
-        
-        if (ex >= camX && ex < camX + 8 && ey >= camY && ey < camY + 8)
-        {
-            uint8_t localX = ex - camX;
-            uint8_t localY = ey - camY;
-            
-            bool blink = (matrixDisplay.getFrameCounter() % GameplayConstants::EXPLOSIVE_BLINK_CYCLE < GameplayConstants::EXPLOSIVE_BLINK_ON_FRAMES);
-            
-            matrixDisplay.setLed(localX, localY, blink);
-        }
+    renderFrame(currentTime);
+}
+
+void GameEngine::renderFrame(unsigned long currentTime)
+{
+    if (!renderScheduler.isFrameDue(currentTime)) {
+        return;
     }
+    
+    matrixDisplay.draw(map, player, camera, currentTime);
+    renderScheduler.endFrame(matrixDisplay.getLastDrawMicros());
 }
 
 void GameEngine::handleInput()
@@ -801,33 +785,75 @@ void GameEngine::handleInput()
     playSoundPattern(BuzzerPattern::HIT_BOMB, GameplayConstants::EXPLOSION_SOUND_DURATION_MS);
         
     lcdDisplay.clear();
-    lcdDisplay.printCentered(0, "BOOM!");
+    char bomb = lcdDisplay.glyph(LCDGlyph::BOMB);
+    LCDFormatter line;
+    line.character(bomb).text(F(" BOOM! ")).character(bomb);
+    lcdDisplay.printCentered(0, line.c_str());
         
-    char buffer[LCDConstants::SMALL_BUFFER_SIZE];
-    sprintf(buffer, "Lives: %d", livesAfter);
-    lcdDisplay.printCentered(1, buffer);
+    line.clear().text(F("Lives: ")).character(lcdDisplay.glyph(LCDGlyph::HEART)).number(livesAfter);
+    lcdDisplay.printCentered(1, line.c_str());
         
     gameState = GameState::BOMB_FEEDBACK;
     feedbackTimer = millis();
     }
 }
 
-void GameEngine::updateLCD()
+void GameEngine::holdHud(uint16_t durationMs)
+{
+    hudHoldStart = millis();
+    hudHoldMs = durationMs;
+    hudDirty = true;
+}
+
+void GameEngine::updateHud()
 {
-    lcdDisplay.clearLine(0);
-    lcdDisplay.clearLine(1);
+    // millis(), not the loop's timestamp: a hold may have started this iteration
+    if (millis() - hudHoldStart < hudHoldMs) {
+        return;
+    }
     
-    char buffer[DisplayConstants::LCD_BUFFER_SIZE];
-    uint8_t collected = player.getGoldCollected();
-    uint8_t total = map.getTotalGold();
-    uint8_t explosives = player.getExplosivesCount();
-    uint8_t lives = player.getLives();
+    if (hudDirty) {
+        lcdDisplay.clear();
+        // Glyphs stay resident in CGRAM, so only the first HUD uploads them
+        lcdDisplay.printGlyph(HudLayout::GOLD_COL - 1, 0, LCDGlyph::GOLD);
+        lcdDisplay.printAt(HudLayout::TOTAL_GOLD_COL - 1, 0, F("/"));
+        lcdDisplay.printGlyph(HudLayout::SCORE_COL - 1, 0, LCDGlyph::STAR);
+        lcdDisplay.printGlyph(HudLayout::LEVEL_COL - 1, 1, LCDGlyph::FLAG);
+        lcdDisplay.printGlyph(HudLayout::LIVES_COL - 1, 1, LCDGlyph::HEART);
+        lcdDisplay.printGlyph(HudLayout::EXPLOSIVES_COL - 1, 1, LCDGlyph::EXPLOSIVE);
+    }
     
-    sprintf(buffer, "G:%d/%d E:%d S:%d", collected, total, explosives, score);
-    lcdDisplay.printAt(0, 0, buffer);
+    setHudField(HudField::GOLD, player.getGoldCollected());
+    setHudField(HudField::TOTAL_GOLD, map.getTotalGold());
+    setHudField(HudField::SCORE, score);
+    setHudField(HudField::LEVEL, currentLevel + 1);
+    setHudField(HudField::LIVES, player.getLives());
+    setHudField(HudField::EXPLOSIVES, player.getExplosivesCount());
     
-    sprintf(buffer, "Lvl:%d L:%d", currentLevel + 1, lives);
-    lcdDisplay.printAt(0, 1, buffer);
+    hudDirty = false;
+}
+
+void GameEngine::setHudField(HudField field, uint16_t value)
+{
+    uint8_t index = static_cast<uint8_t>(field);
+    if (!hudDirty && hudValues[index] == value) {
+        return;
+    }
+    hudValues[index] = value;
+    
+    // Column, row and width of each field, in HudField order
+    static const uint8_t layout[static_cast<uint8_t>(HudField::COUNT)][3] = {
+        { HudLayout::GOLD_COL,       0, HudLayout::GOLD_WIDTH },
+        { HudLayout::TOTAL_GOLD_COL, 0, HudLayout::TOTAL_GOLD_WIDTH },
+        { HudLayout::SCORE_COL,      0, HudLayout::SCORE_WIDTH },
+        { HudLayout::LEVEL_COL,      1, HudLayout::LEVEL_WIDTH },
+        { HudLayout::LIVES_COL,      1, HudLayout::LIVES_WIDTH },
+        { HudLayout::EXPLOSIVES_COL, 1, HudLayout::EXPLOSIVES_WIDTH },
+    };
+    
+    LCDFormatter text;
+    text.number(value, layout[index][2]);
+    lcdDisplay.printAt(layout[index][0], layout[index][1], text.c_str());
 }
 
 void GameEngine::showMenu()
@@ -882,7 +908,8 @@ void GameEngine::showSettingsMenu()
     case MenuIndexConstants::SETTINGS_STARTING_LEVEL: // Starting Level
             lcdDisplay.printAt(0, 0, "Starting Level");
             {
-                String value = "<     " + String(gameSettings.getStartingLevel() + 1) + "     >";
+                LCDFormatter value;
+                value.character('<').spaces(5).number(gameSettings.getStartingLevel() + 1).spaces(5).character('>');
                 lcdDisplay.printAt(0, 1, value.c_str());
             }
             break;
@@ -903,14 +930,16 @@ void GameEngine::showSettingsMenu()
     case MenuIndexConstants::SETTINGS_LCD_BRIGHTNESS: // LCD Brightness
             lcdDisplay.printAt(0, 0, "LCD Bright");
             {
-                String value = "<   " + String(systemSettings.getLCDBrightness()) + "   >";
+                LCDFormatter value;
+                value.character('<').spaces(3).number(systemSettings.getLCDBrightness()).spaces(3).character('>');
                 lcdDisplay.printAt(0, 1, value.c_str());
             }
             break;
     case MenuIndexConstants::SETTINGS_MATRIX_BRIGHTNESS: // Matrix Brightness
             lcdDisplay.printAt(0, 0, "Matrix Bright");
             {
-                String value = "<    " + String(systemSettings.getMatrixBrightness()) + "    >";
+                LCDFormatter value;
+                value.character('<').spaces(4).number(systemSettings.getMatrixBrightness()).spaces(4).character('>');
                 lcdDisplay.printAt(0, 1, value.c_str());
                 
                 matrixDisplay.clear();
@@ -943,6 +972,17 @@ void GameEngine::checkRoomTransition()
     if (currentCameraX != lastCameraX || currentCameraY != lastCameraY)
     {
     playSoundPattern(BuzzerPattern::ROOM_TRANSITION, SoundDurations::ROOM_TRANSITION_MS);
+    
+    // Stepping into a neighbouring room scrolls the matrix over; longer
+    // jumps just snap to the new room
+    int8_t dx = (currentCameraX > lastCameraX) - (currentCameraX < lastCameraX);
+    int8_t dy = (currentCameraY > lastCameraY) - (currentCameraY < lastCameraY);
+    uint8_t distance = abs(currentCameraX - lastCameraX) + abs(currentCameraY - lastCameraY);
+    if (distance == MapConstants::ROOM_SIZE) {
+        matrixDisplay.startRoomScroll(map, currentCameraX, currentCameraY, dx, dy);
+    } else {
+        matrixDisplay.cancelRoomScroll();
+    }
         
     lastCameraX = currentCameraX;
     lastCameraY = currentCameraY;
@@ -973,7 +1013,9 @@ void GameEngine::checkWinCondition()
     uint8_t lives = player.getLives();
     score += lives * GameplayConstants::LIFE_BONUS_MULTIPLIER;
     
-    if (currentLevel == MapConstants::LEVEL_3) {
+    LevelDescriptor level;
+    getLevelDescriptor(currentLevel, level);
+    if (level.flags & LevelFlags::EXPLOSIVE_BONUS) {
     uint8_t explosivesLeft = player.getExplosivesCount();
         if (explosivesLeft == 3) {
             score += GameplayConstants::EXPLOSIVES_BONUS_THREE;
@@ -988,13 +1030,13 @@ void GameEngine::checkWinCondition()
     uint16_t finalScore = (uint16_t)(score * multiplier);
 
     lcdDisplay.clear();
-    char congratsMsg[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    sprintf(congratsMsg, "Congrats lvl %d", currentLevel + 1);
-    lcdDisplay.printCentered(0, congratsMsg);
+    LCDFormatter congratsMsg;
+    congratsMsg.text(F("Congrats lvl ")).number(currentLevel + 1);
+    lcdDisplay.printCentered(0, congratsMsg.c_str());
     
-    char scoreBuffer[LCDConstants::SMALL_BUFFER_SIZE];
-    sprintf(scoreBuffer, "Score: %d", finalScore);
-    lcdDisplay.printCentered(1, scoreBuffer);
+    LCDFormatter scoreLine;
+    scoreLine.text(F("Score: ")).number(finalScore);
+    lcdDisplay.printCentered(1, scoreLine.c_str());
     
     playSoundPattern(BuzzerPattern::LEVEL_COMPLETE, SoundDurations::LEVEL_COMPLETE_MS);
     
@@ -1019,6 +1061,9 @@ void GameEngine::checkExplosivePlacement()
             
             explosivePlacedTime = millis();
             activeExplosive.place(playerX, playerY);
+            matrixDisplay.setOverlay(OverlaySlots::EXPLOSIVE, MatrixLayer::EFFECTS, playerX, playerY,
+                                     GameplayConstants::EXPLOSIVE_BLINK_PERIOD_MS,
+                                     GameplayConstants::EXPLOSIVE_BLINK_ON_MS);
             player.setExplosivesCount(player.getExplosivesCount() - 1);
             explosivesUsedThisLevel++;
             playSound(SoundFrequencies::EXPLOSIVE_PLACED_HZ, SoundDurationConstants::SHORT_BEEP_MS);
@@ -1026,9 +1071,10 @@ void GameEngine::checkExplosivePlacement()
             lcdDisplay.clear();
             lcdDisplay.printCentered(0, "RUN! 5s boom!");
             
-            char buffer[LCDConstants::SMALL_BUFFER_SIZE];
-            sprintf(buffer, "Left: %d", player.getExplosivesCount());
-            lcdDisplay.printCentered(1, buffer);
+            LCDFormatter line;
+            line.text(F("Left: ")).character(lcdDisplay.glyph(LCDGlyph::EXPLOSIVE)).number(player.getExplosivesCount());
+            lcdDisplay.printCentered(1, line.c_str());
+            holdHud(TimingConstants::BOMB_PLACED_LCD_DISPLAY_MS);
         }
         else
         {
@@ -1044,6 +1090,7 @@ void GameEngine::handleExplosion()
     
     activeExplosive.deactivate();
     explosivePlacedTime = 0;      
+    matrixDisplay.clearOverlay(OverlaySlots::EXPLOSIVE);
     uint8_t playerX = player.getX();
     uint8_t playerY = player.getY();
     
@@ -1052,7 +1099,10 @@ void GameEngine::handleExplosion()
         player.setLives(0);
         
         lcdDisplay.clear();
-        lcdDisplay.printCentered(0, "FATAL BOOM!");
+        char bomb = lcdDisplay.glyph(LCDGlyph::BOMB);
+        LCDFormatter line;
+        line.character(bomb).text(F(" FATAL BOOM! ")).character(bomb);
+        lcdDisplay.printCentered(0, line.c_str());
         lcdDisplay.printCentered(1, "Direct hit!");
         
         gameState = GameState::BOMB_FEEDBACK;  
@@ -1070,9 +1120,9 @@ void GameEngine::handleExplosion()
             lcdDisplay.clear();
             lcdDisplay.printCentered(0, "Hit by blast!");
             
-            char buffer[LCDConstants::SMALL_BUFFER_SIZE];
-            sprintf(buffer, "Lives: %d", player.getLives());
-            lcdDisplay.printCentered(1, buffer);
+            LCDFormatter line;
+            line.text(F("Lives: ")).character(lcdDisplay.glyph(LCDGlyph::HEART)).number(player.getLives());
+            lcdDisplay.printCentered(1, line.c_str());
             
             gameState = GameState::BOMB_FEEDBACK; 
             feedbackTimer = millis();
@@ -1094,20 +1144,13 @@ void GameEngine::handleExplosion()
         int16_t targetX = (int16_t)ex + explosionPattern[i][0];
         int16_t targetY = (int16_t)ey + explosionPattern[i][1];
         
-        if (targetX < 0 || targetX >= MapConstants::WORLD_SIZE || 
-            targetY < 0 || targetY >= MapConstants::WORLD_SIZE)
+        if (targetX < 0 || targetY < 0 || !map.isInBounds(targetX, targetY))
         {
             continue;  // Out of bounds
         }
         
-        if (targetX == MapBoundaryConstants::MAP_BOUNDARY_MIN || 
-            targetX == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || 
-            targetX == MapBoundaryConstants::ROOM_SEPARATOR_UPPER || 
-            targetX == MapBoundaryConstants::MAP_BOUNDARY_MAX ||
-            targetY == MapBoundaryConstants::MAP_BOUNDARY_MIN || 
-            targetY == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || 
-            targetY == MapBoundaryConstants::ROOM_SEPARATOR_UPPER || 
-            targetY == MapBoundaryConstants::MAP_BOUNDARY_MAX)
+        // Map border and room separators are indestructible
+        if (Map::isRoomEdge(targetX, targetY))
         {
             continue; 
         }
@@ -1128,8 +1171,7 @@ void GameEngine::handleExplosion()
         int16_t checkX = (int16_t)ex + explosionPattern[i][0];
         int16_t checkY = (int16_t)ey + explosionPattern[i][1];
         
-        if (checkX < 0 || checkX >= MapConstants::WORLD_SIZE || 
-            checkY < 0 || checkY >= MapConstants::WORLD_SIZE)
+        if (checkX < 0 || checkY < 0 || !map.isInBounds(checkX, checkY))
         {
             continue;
         }
@@ -1144,8 +1186,7 @@ void GameEngine::handleExplosion()
             int16_t nx = checkX + neighbors[j][0];
             int16_t ny = checkY + neighbors[j][1];
             
-            if (nx >= 0 && nx < MapConstants::WORLD_SIZE && 
-                ny >= 0 && ny < MapConstants::WORLD_SIZE)
+            if (nx >= 0 && ny >= 0 && map.isInBounds(nx, ny))
             {
                 if (map.getTile(nx, ny) == TileType::HIDDEN_GOLD && 
                     map.getTile(safeX, safeY) == TileType::EMPTY)
@@ -1155,6 +1196,8 @@ void GameEngine::handleExplosion()
             }
         }
     }
+    
+    player.refreshTreasureProximity();
 }
 
 void GameEngine::playSound(uint16_t frequency, uint16_t duration)
@@ -1175,117 +1218,60 @@ void GameEngine::showHighscores()
 {
     lcdDisplay.clear();
     matrixDisplay.clear();      
-    char buffer[SystemDefaultConstants::LCD_BUFFER_SIZE];
     
-    if (highscoreScrollPos == 0) {
-    const HighscoreEntry& entry1 = highscoreManager.getEntry(0);
-    const HighscoreEntry& entry2 = highscoreManager.getEntry(1);
-        
-    if (entry1.score > 0) {
-        sprintf(buffer, "1.%c%c%c %d", 
-                entry1.name[0], entry1.name[1], entry1.name[2], 
-                entry1.score);
-    } else 
-    {
-        sprintf(buffer, "1.--- 0");
-    }
-    lcdDisplay.printAt(0, 0, buffer);
-        
-    if (entry2.score > 0) {
-        sprintf(buffer, "2.%c%c%c %d", 
-                entry2.name[0], entry2.name[1], entry2.name[2], 
-                entry2.score);
-    } else 
-    {
-        sprintf(buffer, "2.--- 0");
-    }
-    lcdDisplay.printAt(0, 1, buffer);
-    }
-    else {
-        const HighscoreEntry& entry2 = highscoreManager.getEntry(1);
-        const HighscoreEntry& entry3 = highscoreManager.getEntry(2);
-        
-        if (entry2.score > 0) {
-            sprintf(buffer, "2.%c%c%c %d", 
-                    entry2.name[0], entry2.name[1], entry2.name[2], 
-                    entry2.score);
-        } 
-        else {
-            sprintf(buffer, "2.--- 0");
-        }
-    lcdDisplay.printAt(0, 0, buffer);
-        
-    if (entry3.score > 0) {
-        sprintf(buffer, "3.%c%c%c %d", 
-                entry3.name[0], entry3.name[1], entry3.name[2], 
-                entry3.score);
-        lcdDisplay.printAt(0, 1, buffer);
-    } else 
-    {
-        sprintf(buffer, "3.--- 0");
-        lcdDisplay.printAt(0, 1, buffer);
-    }
-    }
+    // Two of the three entries fit; scrolling shows 2-3 instead of 1-2
+    uint8_t first = (highscoreScrollPos == 0) ? 0 : 1;
+    printHighscoreRow(first, 0);
+    printHighscoreRow(first + 1, 1);
     
     lcdDisplay.printAt(10, 1, "H:rst");
 }
 
+void GameEngine::printHighscoreRow(uint8_t index, uint8_t row)
+{
+    const HighscoreEntry& entry = highscoreManager.getEntry(index);
+    
+    LCDFormatter line;
+    line.number(index + 1).character('.');
+    if (entry.score > 0) {
+    line.character(entry.name[0]).character(entry.name[1]).character(entry.name[2])
+        .character(' ').number(entry.score);
+    } else {
+    line.text(F("--- 0"));
+    }
+    lcdDisplay.printAt(0, row, line.c_str());
+}
+
 void GameEngine::showNameEditor()
 {
     lcdDisplay.clear();
     
     lcdDisplay.printAt(0, 0, "Enter Name:");
     
-    char display[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    sprintf(display, " %c %c %c", 
-            editedName[0], 
-            editedName[1], 
-            editedName[2]);
-    lcdDisplay.printAt(0, 1, display);
+    LCDFormatter display;
+    for (uint8_t i = 0; i < HighscoreConstants::HIGHSCORE_NAME_LENGTH; i++) {
+    display.character(' ').character(editedName[i]);
+    }
+    lcdDisplay.printAt(0, 1, display.c_str());
     
     uint8_t cursorPos = 1 + nameEditPosition * 2;
+    const char selected[] = { editedName[nameEditPosition], '\0' };
     lcdDisplay.printAt(cursorPos, 1, "_");
-    lcdDisplay.printAt(cursorPos, 1, String(editedName[nameEditPosition]).c_str());
+    lcdDisplay.printAt(cursorPos, 1, selected);
 }
 
 void GameEngine::showAbout()
 {
-    lcdDisplay.clear();
-    
-    const char* fullText = "The Miner by Alexandra Neamtu   Github: github.com/ale0204   ";
-    uint8_t textLen = strlen(fullText);
-    
-    uint8_t offset = aboutScrollOffset % textLen;
-    
-    char line[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    for (uint8_t i = 0; i < LCDConstants::COLS; i++) {
-    line[i] = fullText[(offset + i) % textLen];
-    }
-    line[LCDConstants::COLS] = '\0';
-    
-    lcdDisplay.printAt(0, 0, line);
-    lcdDisplay.printAt(0, 1, "Press to exit");
+    marquee.start(F("The Miner by Alexandra Neamtu   Github: github.com/ale0204   "),
+                  F("Press to exit"), millis());
     
     matrixDisplay.clear();
 }
 
 void GameEngine::showHowToPlay()
 {
-    lcdDisplay.clear();
-    
-    const char* fullText = "Collect gold! Avoid bombs using light. Place explosives to get hidden gold.   ";
-    uint8_t textLen = strlen(fullText);
-    
-    uint8_t offset = howToPlayScrollOffset % textLen;
-    
-    char line[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    for (uint8_t i = 0; i < LCDConstants::COLS; i++) {
-    line[i] = fullText[(offset + i) % textLen];
-    }
-    line[LCDConstants::COLS] = '\0';
-    
-    lcdDisplay.printAt(0, 0, line);
-    lcdDisplay.printAt(0, 1, "Press to exit");
+    marquee.start(F("Collect gold! Avoid bombs using light. Place explosives to get hidden gold.   "),
+                  F("Press to exit"), millis());
     
     matrixDisplay.clear();
 }
@@ -1294,13 +1280,12 @@ void GameEngine::showLevelStats()
 {
     lcdDisplay.clear();
     
-    char line1[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    sprintf(line1, "Score:%d Life:%d", score, player.getLives());
-    lcdDisplay.printAt(0, 0, line1);
+    LCDFormatter line;
+    line.text(F("Score:")).number(score).text(F(" Life:")).number(player.getLives());
+    lcdDisplay.printAt(0, 0, line.c_str());
     
-    char line2[SystemDefaultConstants::LCD_BUFFER_SIZE];
-    sprintf(line2, "Exp:%d Press BTN", explosivesUsedThisLevel);
-    lcdDisplay.printAt(0, 1, line2);
+    line.clear().text(F("Exp:")).number(explosivesUsedThisLevel).text(F(" Press BTN"));
+    lcdDisplay.printAt(0, 1, line.c_str());
     
     matrixDisplay.clear();
 }
@@ -13,6 +13,8 @@
 #include "GameSettings.h"
 #include "SystemSettings.h"
 #include "HighscoreManager.h"
+#include "RenderScheduler.h"
+#include "LCDMarquee.h"
 #include "Constants.h"
 
 enum class GameState : uint8_t
@@ -45,6 +47,7 @@ private:
     GameSettings gameSettings;
     SystemSettings systemSettings;
     HighscoreManager highscoreManager;
+    RenderScheduler renderScheduler;
     
     ActiveExplosive activeExplosive;
     unsigned long explosivePlacedTime;
@@ -62,7 +65,6 @@ private:
     uint16_t score;
     uint8_t explosivesUsedThisLevel;
     unsigned long lastUpdateTime;
-    unsigned long lastLCDUpdate;
     unsigned long lastMenuNavigationTime;
     unsigned long lastSettingsNavigationTime;
     unsigned long feedbackTimer;
@@ -71,17 +73,29 @@ private:
     bool waitingForMessageDisplay;
     GameState stateAfterMessage;
     
-    uint8_t aboutScrollOffset;
-    unsigned long lastAboutScrollTime;
-    
-    uint8_t howToPlayScrollOffset;
-    unsigned long lastHowToPlayScrollTime;
+    LCDMarquee marquee;         // About / How To Play text
     
     uint8_t lastCameraX;
     uint8_t lastCameraY;
     
+    // In-game HUD: each field is redrawn only when its value changes
+    enum class HudField : uint8_t
+    {
+        GOLD,
+        TOTAL_GOLD,
+        SCORE,
+        LEVEL,
+        LIVES,
+        EXPLOSIVES,
+        COUNT
+    };
+    uint16_t hudValues[static_cast<uint8_t>(HudField::COUNT)];
+    bool hudDirty;                 // labels and every field need drawing
+    unsigned long hudHoldStart;    // a message owns the LCD until hudHoldMs passed
+    uint16_t hudHoldMs;
+    
     static const unsigned long UPDATE_INTERVAL = 200;
-    static const unsigned long LCD_UPDATE_INTERVAL = 500;
+    static const uint16_t LEVEL_BANNER_MS = 500;
 
 public:
     GameEngine(MatrixDisplay& matrix, LCDDisplay& lcd, Joystick& joy, Buzzer& buzz);
@@ -89,16 +103,23 @@ public:
     void begin();
     void update();
     void loadLevel(uint8_t levelIndex);
+    
+    const RenderScheduler& getRenderScheduler() const { return renderScheduler; }
+    RenderScheduler& getRenderScheduler() { return renderScheduler; }
 
 private:
     void handleInput();
-    void updateLCD();
+    void renderFrame(unsigned long currentTime);
+    void updateHud();
+    void setHudField(HudField field, uint16_t value);
+    void holdHud(uint16_t durationMs);
     void checkWinCondition();
     void checkExplosivePlacement();
     void handleExplosion();
     void showMenu();
     void showSettingsMenu();
     void showHighscores();
+    void printHighscoreRow(uint8_t index, uint8_t row);
     void showNameEditor();
     void showAbout();
     void showHowToPlay();
@@ -1,4 +1,5 @@
 #include "GameSettings.h"
+#include "Levels.h"
 #include <EEPROM.h>
 
 GameSettings::GameSettings()
@@ -33,16 +34,10 @@ const char* GameSettings::getDifficultyName() const
 
 float GameSettings::getScoreMultiplier() const
 {
-    float baseMult;
-    
     // Starting level bonus
-    switch (startingLevel) {
-        case 0: baseMult = DifficultyConstants::SCORE_MULT_LEVEL_0; break;
-        case 1: baseMult = DifficultyConstants::SCORE_MULT_LEVEL_1; break;
-        case 2: baseMult = DifficultyConstants::SCORE_MULT_LEVEL_2; break;
-        case 3: baseMult = DifficultyConstants::SCORE_MULT_LEVEL_3; break;
-        default: baseMult = DifficultyConstants::SCORE_MULT_LEVEL_0; break;
-    }
+    LevelDescriptor level;
+    getLevelDescriptor(startingLevel, level);
+    float baseMult = level.scoreMultTenths / 10.0f;
     
     // Difficulty multiplier bonus
     switch (difficulty) {
@@ -53,29 +48,38 @@ float GameSettings::getScoreMultiplier() const
     }
 }
 
-uint8_t GameSettings::getMaxBombsForLevel(uint8_t level) const
+// Shifts a NORMAL-difficulty bomb count from the level table by the difficulty
+uint8_t GameSettings::adjustBombsForDifficulty(uint8_t bombs) const
 {
-        uint8_t baseBombs;
-    switch (level) {
-        case MapConstants::LEVEL_0: baseBombs = DifficultyConstants::LEVEL_0_BASE_BOMBS; break;
-        case MapConstants::LEVEL_1: baseBombs = DifficultyConstants::LEVEL_1_BASE_BOMBS; break;
-        case MapConstants::LEVEL_2: baseBombs = DifficultyConstants::LEVEL_2_BASE_BOMBS; break;
-        case MapConstants::LEVEL_3: baseBombs = DifficultyConstants::LEVEL_3_BASE_BOMBS; break;
-        default: baseBombs = DifficultyConstants::LEVEL_1_BASE_BOMBS; break;
+    switch (difficulty) {
+        case EASY:   return bombs > DifficultyConstants::EASY_BOMB_REDUCTION ? bombs - DifficultyConstants::EASY_BOMB_REDUCTION : 0;
+        case HARD:   return bombs + DifficultyConstants::HARD_BOMB_INCREASE;
+        case NORMAL: return bombs;
+        default:     return bombs;
     }
+}
+
+uint8_t GameSettings::getMaxBombsForLevel(uint8_t level) const
+{
+    LevelDescriptor descriptor;
+    getLevelDescriptor(level, descriptor);
     
-        switch (difficulty) {
-        case EASY:   return baseBombs > 0 ? baseBombs - DifficultyConstants::EASY_BOMB_REDUCTION : 0;
-        case NORMAL: return baseBombs;
-        case HARD:   return baseBombs + DifficultyConstants::HARD_BOMB_INCREASE; 
-        default:     return baseBombs;
+    // Bomb-free levels stay bomb-free on every difficulty
+    if (descriptor.maxBombs == 0) {
+        return 0;
     }
+    return adjustBombsForDifficulty(descriptor.maxBombs);
 }
 
 uint8_t GameSettings::getMinBombsForLevel(uint8_t level) const
 {
-    uint8_t maxBombs = getMaxBombsForLevel(level);
-    return maxBombs > DifficultyConstants::MIN_BOMBS_REDUCTION ? maxBombs - DifficultyConstants::MIN_BOMBS_REDUCTION : 0;
+    LevelDescriptor descriptor;
+    getLevelDescriptor(level, descriptor);
+    
+    if (descriptor.maxBombs == 0) {
+        return 0;
+    }
+    return adjustBombsForDifficulty(descriptor.minBombs);
 }
 
 // placeRandomBombs(min, max) need a range, and chooses a random number in that range
@@ -41,6 +41,9 @@ public:
     uint8_t getMaxBombsForLevel(uint8_t level) const;
     uint8_t getMinBombsForLevel(uint8_t level) const;
     uint8_t getStartingLives() const;
+
+private:
+    uint8_t adjustBombsForDifficulty(uint8_t bombs) const;
 };
 
 #endif // GAME_SETTINGS_H
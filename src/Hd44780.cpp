@@ -0,0 +1,223 @@
+#include "Hd44780.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#define pgm_read_word(p) (*(p))
+#endif
+
+namespace
+{
+    enum PinIndex : uint8_t { RS_PIN, EN_PIN, D4_PIN, PIN_COUNT = D4_PIN + 4 };
+
+    // Execution time in us, indexed by the highest set bit of a command byte
+    // (CLEAR_DISPLAY, RETURN_HOME, then every other instruction). Datasheet
+    // figures scaled to the slowest allowed oscillator (190 kHz instead of
+    // 270 kHz), plus one micros() tick (4 us) of rounding.
+    const uint16_t COMMAND_EXECUTION_US[8] PROGMEM = {
+        2164, 2164, 57, 57, 57, 57, 57, 57
+    };
+    constexpr uint16_t DATA_EXECUTION_US = 63;  // 37 + 4 us (tADD), scaled the same way
+
+    // Power-up: the controller may be in 8-bit mode or halfway through a
+    // 4-bit transfer, so it is forced to 8-bit three times, then to 4-bit
+    constexpr unsigned long POWER_ON_DELAY_MS = 50;
+    constexpr uint16_t INIT_NIBBLE_US[4] = { 4500, 4500, 150, 150 };
+    constexpr uint8_t INIT_NIBBLES[4] = { 0x03, 0x03, 0x03, 0x02 };
+
+    constexpr uint8_t ROW_OFFSETS[2] = { 0x00, Hd44780Commands::ROW_1_OFFSET };
+}
+
+Hd44780::Hd44780(uint8_t rs, uint8_t en, uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7)
+    : pins{rs, en, d4, d5, d6, d7}
+    , readyAt(0)
+    , transfers(0)
+    , waitMicros(0)
+#ifdef HD44780_MOCK
+    , mockLogLength(0)
+    , mockClock(0)
+#endif
+{
+}
+
+void Hd44780::begin()
+{
+#ifndef HD44780_MOCK
+    for (uint8_t i = 0; i < PIN_COUNT; i++)
+    {
+        pinMode(pins[i], OUTPUT);
+        ports[i] = portOutputRegister(digitalPinToPort(pins[i]));
+        masks[i] = digitalPinToBitMask(pins[i]);
+        *ports[i] &= ~masks[i];
+    }
+
+    delay(POWER_ON_DELAY_MS);
+#endif
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+#ifdef HD44780_MOCK
+        if (mockLogLength < MOCK_LOG_SIZE)
+        {
+            mockLog[mockLogLength++] = { static_cast<uint8_t>(INIT_NIBBLES[i] << 4), false, mockClock };
+        }
+        mockClock += INIT_NIBBLE_US[i];
+#else
+        writeNibble(INIT_NIBBLES[i]);
+        delayMicroseconds(INIT_NIBBLE_US[i]);
+#endif
+    }
+    readyAt = now();
+
+    command(Hd44780Commands::FUNCTION_SET | Hd44780Commands::TWO_LINES);
+    command(Hd44780Commands::DISPLAY_CONTROL | Hd44780Commands::DISPLAY_ON);  // no cursor, no blink
+    command(Hd44780Commands::CLEAR_DISPLAY);
+    command(Hd44780Commands::ENTRY_MODE_SET | Hd44780Commands::ENTRY_INCREMENT);
+}
+
+void Hd44780::command(uint8_t value)
+{
+    send(value, false);
+}
+
+size_t Hd44780::write(uint8_t value)
+{
+    send(value, true);
+    return 1;
+}
+
+void Hd44780::setCursor(uint8_t col, uint8_t row)
+{
+    if (row > 1)
+    {
+        row = 1;
+    }
+    command(Hd44780Commands::SET_DDRAM_ADDR | (ROW_OFFSETS[row] + col));
+}
+
+void Hd44780::clear()
+{
+    command(Hd44780Commands::CLEAR_DISPLAY);
+}
+
+void Hd44780::createChar(uint8_t slot, const uint8_t* rows)
+{
+    command(Hd44780Commands::SET_CGRAM_ADDR | ((slot & (Hd44780Commands::CGRAM_SLOTS - 1)) << 3));
+    for (uint8_t i = 0; i < Hd44780Commands::CGRAM_ROWS; i++)
+    {
+        write(rows[i]);
+    }
+}
+
+bool Hd44780::isReady() const
+{
+    return static_cast<long>(now() - readyAt) >= 0;
+}
+
+uint16_t Hd44780::executionMicros(uint8_t value, bool isData)
+{
+    if (isData)
+    {
+        return DATA_EXECUTION_US;
+    }
+
+    uint8_t highestBit = 7;
+    while (highestBit > 0 && !(value & (1 << highestBit)))
+    {
+        highestBit--;
+    }
+    return pgm_read_word(&COMMAND_EXECUTION_US[highestBit]);
+}
+
+void Hd44780::waitReady()
+{
+    long remaining = static_cast<long>(readyAt - now());
+    if (remaining <= 0)
+    {
+        return;
+    }
+
+    waitMicros += remaining;
+#ifdef HD44780_MOCK
+    mockClock = readyAt;
+#else
+    while (static_cast<long>(readyAt - micros()) > 0)
+    {
+    }
+#endif
+}
+
+void Hd44780::send(uint8_t value, bool isData)
+{
+    waitReady();
+
+#ifdef HD44780_MOCK
+    if (mockLogLength < MOCK_LOG_SIZE)
+    {
+        mockLog[mockLogLength++] = { value, isData, mockClock };
+    }
+#else
+    // The LCD pins share PORTB/PORTD with other pins; keep ISRs from
+    // interleaving a read-modify-write during the transfer
+    uint8_t savedSREG = SREG;
+    cli();
+    if (isData)
+    {
+        *ports[RS_PIN] |= masks[RS_PIN];
+    }
+    else
+    {
+        *ports[RS_PIN] &= ~masks[RS_PIN];
+    }
+    writeNibble(value >> 4);
+    writeNibble(value & 0x0F);
+    SREG = savedSREG;
+#endif
+
+    readyAt = now() + executionMicros(value, isData);
+    transfers++;
+}
+
+unsigned long Hd44780::now() const
+{
+#ifdef HD44780_MOCK
+    return mockClock;
+#else
+    return micros();
+#endif
+}
+
+#ifdef HD44780_MOCK
+
+void Hd44780::clearMockLog()
+{
+    mockLogLength = 0;
+}
+
+void Hd44780::writeNibble(uint8_t)
+{
+}
+
+#else
+
+void Hd44780::writeNibble(uint8_t nibble)
+{
+    for (uint8_t bit = 0; bit < 4; bit++)
+    {
+        if (nibble & (1 << bit))
+        {
+            *ports[D4_PIN + bit] |= masks[D4_PIN + bit];
+        }
+        else
+        {
+            *ports[D4_PIN + bit] &= ~masks[D4_PIN + bit];
+        }
+    }
+
+    // Latched on the falling edge of EN; PWeh >= 450 ns, tcycE >= 1000 ns
+    *ports[EN_PIN] |= masks[EN_PIN];
+    delayMicroseconds(1);
+    *ports[EN_PIN] &= ~masks[EN_PIN];
+    delayMicroseconds(1);
+}
+
+#endif
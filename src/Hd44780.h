@@ -0,0 +1,111 @@
+#ifndef HD44780_H
+#define HD44780_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+// Native 4-bit driver for HD44780 character LCDs with R/W tied to ground.
+// The busy flag can't be read, so every transfer records when the controller
+// will be ready again (execution time from a per-command table) and the next
+// transfer waits only for whatever is left of that, instead of LiquidCrystal's
+// fixed 100 us per nibble. Pins are driven through their port registers.
+// Building with HD44780_MOCK (or on a host without ARDUINO) records the
+// transfer stream with simulated timestamps instead.
+#if !defined(ARDUINO) && !defined(HD44780_MOCK)
+#define HD44780_MOCK
+#endif
+
+namespace Hd44780Commands
+{
+    constexpr uint8_t CLEAR_DISPLAY   = 0x01;
+    constexpr uint8_t RETURN_HOME     = 0x02;
+    constexpr uint8_t ENTRY_MODE_SET  = 0x04;
+    constexpr uint8_t DISPLAY_CONTROL = 0x08;
+    constexpr uint8_t CURSOR_SHIFT    = 0x10;
+    constexpr uint8_t FUNCTION_SET    = 0x20;
+    constexpr uint8_t SET_CGRAM_ADDR  = 0x40;
+    constexpr uint8_t SET_DDRAM_ADDR  = 0x80;
+
+    // Flags
+    constexpr uint8_t ENTRY_INCREMENT = 0x02;
+    constexpr uint8_t DISPLAY_ON      = 0x04;
+    constexpr uint8_t SHIFT_DISPLAY   = 0x08;  // CURSOR_SHIFT: move the display, not the cursor
+    constexpr uint8_t SHIFT_RIGHT     = 0x04;
+    constexpr uint8_t TWO_LINES       = 0x08;
+
+    constexpr uint8_t ROW_1_OFFSET    = 0x40;  // DDRAM address of row 1, column 0
+    constexpr uint8_t CGRAM_SLOTS     = 8;     // 5x8 custom characters, codes 0-7 (and 8-15)
+    constexpr uint8_t CGRAM_ROWS      = 8;     // bytes per character, low 5 bits used
+}
+
+class Hd44780
+{
+public:
+#ifdef HD44780_MOCK
+    static const uint16_t MOCK_LOG_SIZE = 256;
+
+    struct MockTransfer
+    {
+        uint8_t value;
+        bool isData;          // RS high
+        unsigned long at;     // simulated micros() when it was sent
+    };
+#endif
+
+    Hd44780(uint8_t rs, uint8_t en, uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+
+    // Power-up sequence; blocks for ~50 ms, setup() only
+    void begin();
+
+    void command(uint8_t value);
+    size_t write(uint8_t value);
+
+    void setCursor(uint8_t col, uint8_t row);
+    void clear();
+    // Loads a custom character (CGRAM_ROWS bytes). Leaves the address
+    // counter in CGRAM, so call setCursor() before writing text again
+    void createChar(uint8_t slot, const uint8_t* rows);
+
+    // Has the last transfer finished executing?
+    bool isReady() const;
+
+    unsigned long getTransfers() const { return transfers; }
+    unsigned long getWaitMicros() const { return waitMicros; }  // time spent waiting on readyAt
+
+#ifdef HD44780_MOCK
+    const MockTransfer* getMockLog() const { return mockLog; }
+    uint16_t getMockLogLength() const { return mockLogLength; }
+    void clearMockLog();
+    // Lets host tests simulate work done between transfers
+    void advanceMockClock(unsigned long us) { mockClock += us; }
+    unsigned long getMockClock() const { return mockClock; }
+#endif
+
+private:
+    uint8_t pins[6];          // RS, EN, D4..D7
+    unsigned long readyAt;    // micros() at which the controller accepts the next transfer
+
+    unsigned long transfers;
+    unsigned long waitMicros;
+
+#ifdef HD44780_MOCK
+    MockTransfer mockLog[MOCK_LOG_SIZE];
+    uint16_t mockLogLength;
+    unsigned long mockClock;
+#else
+    volatile uint8_t* ports[6];
+    uint8_t masks[6];
+#endif
+
+    unsigned long now() const;
+    void waitReady();
+    void send(uint8_t value, bool isData);
+    void writeNibble(uint8_t nibble);
+    static uint16_t executionMicros(uint8_t value, bool isData);
+};
+
+#endif // HD44780_H
@@ -1,18 +1,50 @@
 #include "LCDDisplay.h"
 
-LCDDisplay::LCDDisplay(LiquidCrystal& lcdRef)
+namespace
+{
+    // 5x8 bitmaps, one row per byte, in LCDGlyph order
+    const uint8_t GLYPH_BITMAPS[static_cast<uint8_t>(LCDGlyph::COUNT)][Hd44780Commands::CGRAM_ROWS] PROGMEM = {
+        { B00000, B01110, B11111, B11011, B11011, B11111, B01110, B00000 },  // GOLD
+        { B00000, B01010, B11111, B11111, B11111, B01110, B00100, B00000 },  // HEART
+        { B00001, B00010, B00100, B01110, B01110, B01110, B01110, B01110 },  // EXPLOSIVE
+        { B00010, B00100, B01110, B11111, B11111, B11111, B01110, B00000 },  // BOMB
+        { B00100, B00100, B11111, B01110, B01010, B10001, B00000, B00000 },  // STAR
+        { B10000, B11100, B11111, B11100, B10000, B10000, B10000, B00000 },  // FLAG
+    };
+}
+
+LCDDisplay::LCDDisplay(Hd44780& lcdRef)
     : lcd(lcdRef)
     , ledPin(LCDPins::LED)
     , currentBrightness(255)
+    , cursorCol(LCDConstants::COLS)
+    , cursorRow(0)
+    , maxQueueDepth(0)
+    , lastDrainMicros(0)
+    , maxDrainMicros(0)
+    , cellsWritten(0)
+    , cursorMoves(0)
+    , glyphUploads(0)
 {
+    memset(desired, ' ', sizeof(desired));
+    invalidate();
+    resetGlyphSlots();
 }
 
 void LCDDisplay::init()
 {
-    lcd.begin(LCDConstants::COLS, LCDConstants::ROWS);
-    lcd.noCursor();
-    lcd.noBlink();
-    lcd.clear();
+    // Power-up sequence ends with the display cleared, cursor and blink off
+    lcd.begin();
+    
+    // From here on the shadow knows the screen is blank
+    memset(desired, ' ', sizeof(desired));
+    memset(shown, ' ', sizeof(shown));
+    memset(dirtyCells, 0, sizeof(dirtyCells));
+    cursorCol = 0;
+    cursorRow = 0;
+    
+    // CGRAM content is undefined after power-up
+    resetGlyphSlots();
     
     // Setup LED backlight pin
     pinMode(ledPin, OUTPUT);
@@ -27,19 +59,83 @@ void LCDDisplay::setBrightness(uint8_t brightness)
 
 void LCDDisplay::clear()
 {
-    lcd.clear();
+    // No lcd.clear() (about 2 ms blocking); only lit cells get blanked
+    for (byte row = 0; row < LCDConstants::ROWS; row++)
+    {
+        clearLine(row);
+    }
+}
+
+void LCDDisplay::putChar(byte col, byte row, char c)
+{
+    if (col < LCDConstants::COLS && row < LCDConstants::ROWS)
+    {
+        desired[row][col] = c;
+        
+        uint16_t bit = 1u << col;
+        if (c != shown[row][col])
+        {
+            dirtyCells[row] |= bit;
+        }
+        else
+        {
+            dirtyCells[row] &= ~bit;  // changed back before it was sent
+        }
+    }
+}
+
+void LCDDisplay::markRow(byte row)
+{
+    dirtyCells[row] = 0;
+    for (byte col = 0; col < LCDConstants::COLS; col++)
+    {
+        if (desired[row][col] != shown[row][col])
+        {
+            dirtyCells[row] |= 1u << col;
+        }
+    }
 }
 
 void LCDDisplay::printAt(byte col, byte row, const char* text)
 {
-    lcd.setCursor(col, row);
-    lcd.print(text);
+    while (*text && col < LCDConstants::COLS)
+    {
+        putChar(col++, row, *text++);
+    }
 }
 
 void LCDDisplay::printAt(byte col, byte row, const __FlashStringHelper* text)
 {
-    lcd.setCursor(col, row);
-    lcd.print(text);
+    const char* p = reinterpret_cast<const char*>(text);
+    char c;
+    while (col < LCDConstants::COLS && (c = pgm_read_byte(p++)) != '\0')
+    {
+        putChar(col++, row, c);
+    }
+}
+
+char LCDDisplay::glyph(LCDGlyph id)
+{
+    uint8_t glyphId = static_cast<uint8_t>(id);
+    
+    uint8_t slot = 0;
+    while (slot < Hd44780Commands::CGRAM_SLOTS && slotGlyphs[slot] != glyphId)
+    {
+        slot++;
+    }
+    if (slot == Hd44780Commands::CGRAM_SLOTS)
+    {
+        slot = evictSlot();
+        uploadGlyph(slot, glyphId);
+    }
+    
+    touchSlot(slot);
+    return LCDConstants::GLYPH_CODE_BASE + slot;
+}
+
+void LCDDisplay::printGlyph(byte col, byte row, LCDGlyph id)
+{
+    putChar(col, row, glyph(id));
 }
 
 void LCDDisplay::printCentered(byte row, const char* text)
@@ -71,10 +167,10 @@ void LCDDisplay::printCentered(byte row, const __FlashStringHelper* text)
 
 void LCDDisplay::clearLine(byte row)
 {
-    lcd.setCursor(0, row);
-    for (byte i = 0; i < LCDConstants::COLS; i++)
+    if (row < LCDConstants::ROWS)
     {
-        lcd.write(' ');
+        memset(desired[row], ' ', LCDConstants::COLS);
+        markRow(row);
     }
 }
 
@@ -92,7 +188,240 @@ void LCDDisplay::showMessage(const __FlashStringHelper* line1, const __FlashStri
     printCentered(1, line2);
 }
 
-LiquidCrystal& LCDDisplay::getLcd()
+void LCDDisplay::update()
+{
+    drain(LCDConstants::DRAIN_BUDGET_US, LCDConstants::MAX_TRANSFERS_PER_TICK);
+}
+
+void LCDDisplay::flush()
+{
+    drain(0, 0);
+}
+
+uint8_t LCDDisplay::getQueueDepth() const
+{
+    uint8_t depth = 0;
+    for (uint8_t row = 0; row < LCDConstants::ROWS; row++)
+    {
+        for (uint16_t pending = dirtyCells[row]; pending; pending &= pending - 1)
+        {
+            depth++;
+        }
+    }
+    return depth;
+}
+
+// Budget and transfer limits of 0 mean unlimited and allow waiting on the
+// LCD; with a budget, cells the LCD isn't ready for stay queued
+void LCDDisplay::drain(uint16_t budgetMicros, uint8_t maxTransfers)
+{
+    uint8_t col, row;
+    if (!nextDirtyCell(col, row))
+    {
+        return;
+    }
+    
+    uint8_t depth = getQueueDepth();
+    if (depth > maxQueueDepth)
+    {
+        maxQueueDepth = depth;
+    }
+    
+    unsigned long drainStart = micros();
+    uint8_t transfers = 0;
+    
+    do
+    {
+        if (budgetMicros > 0 && !lcd.isReady())
+        {
+            break;
+        }
+        
+        writeCell(col, row);
+        transfers++;
+        
+        if (maxTransfers > 0 && transfers >= maxTransfers)
+        {
+            break;
+        }
+        if (budgetMicros > 0 && micros() - drainStart >= budgetMicros)
+        {
+            break;
+        }
+    } while (nextDirtyCell(col, row));
+    
+    lastDrainMicros = micros() - drainStart;
+    if (lastDrainMicros > maxDrainMicros)
+    {
+        maxDrainMicros = lastDrainMicros;
+    }
+}
+
+// Dirty cells from the cursor onwards come first, so runs keep using the
+// LCD's address auto-increment
+bool LCDDisplay::nextDirtyCell(uint8_t& col, uint8_t& row) const
+{
+    for (uint8_t i = 0; i < LCDConstants::ROWS; i++)
+    {
+        uint8_t r = (cursorRow + i) % LCDConstants::ROWS;
+        uint16_t pending = dirtyCells[r];
+        
+        if (i == 0 && cursorCol < LCDConstants::COLS && (pending >> cursorCol))
+        {
+            pending &= static_cast<uint16_t>(0xFFFF << cursorCol);
+        }
+        
+        if (pending)
+        {
+            uint8_t c = 0;
+            while (!(pending & 1))
+            {
+                pending >>= 1;
+                c++;
+            }
+            col = c;
+            row = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+// One transfer towards dirty cell (col, row). Getting the cursor there
+// (a cursor command, or rewriting a one-cell gap) is a transfer of its own
+// and leaves the cell dirty, so drain() can check the LCD before each byte.
+void LCDDisplay::writeCell(uint8_t col, uint8_t row)
+{
+    // A gap of one clean cell is rewritten, which costs the same single
+    // transfer as a cursor command
+    if (row == cursorRow && col == cursorCol + 1)
+    {
+        lcd.write(desired[row][cursorCol]);
+        cursorCol++;
+        cellsWritten++;
+        return;
+    }
+    if (col != cursorCol || row != cursorRow)
+    {
+        lcd.setCursor(col, row);
+        cursorCol = col;
+        cursorRow = row;
+        cursorMoves++;
+        return;
+    }
+    
+    char c = desired[row][col];
+    lcd.write(c);
+    shown[row][col] = c;
+    dirtyCells[row] &= ~(1u << col);
+    cursorCol = col + 1;
+    cellsWritten++;
+}
+
+void LCDDisplay::invalidate()
+{
+    // Text never contains '\0', so every cell compares as changed
+    memset(shown, 0, sizeof(shown));
+    for (byte row = 0; row < LCDConstants::ROWS; row++)
+    {
+        dirtyCells[row] = 0xFFFF;
+    }
+    cursorCol = LCDConstants::COLS;
+}
+
+void LCDDisplay::resetGlyphSlots()
+{
+    for (uint8_t i = 0; i < Hd44780Commands::CGRAM_SLOTS; i++)
+    {
+        slotGlyphs[i] = NO_GLYPH;
+        slotOrder[i] = Hd44780Commands::CGRAM_SLOTS - 1 - i;  // slot 0 is used first
+    }
+}
+
+void LCDDisplay::touchSlot(uint8_t slot)
+{
+    uint8_t i = 0;
+    while (slotOrder[i] != slot)
+    {
+        i++;
+    }
+    for (; i > 0; i--)
+    {
+        slotOrder[i] = slotOrder[i - 1];
+    }
+    slotOrder[0] = slot;
+}
+
+// Least recently used slot that the desired text doesn't show; reloading a
+// slot changes every cell displaying it at once. If all of them are in use,
+// the least recently used one goes anyway.
+uint8_t LCDDisplay::evictSlot() const
+{
+    for (int8_t i = Hd44780Commands::CGRAM_SLOTS - 1; i >= 0; i--)
+    {
+        uint8_t slot = slotOrder[i];
+        if (slotGlyphs[slot] == NO_GLYPH ||
+            !memchr(desired, LCDConstants::GLYPH_CODE_BASE + slot, sizeof(desired)))
+        {
+            return slot;
+        }
+    }
+    return slotOrder[Hd44780Commands::CGRAM_SLOTS - 1];
+}
+
+void LCDDisplay::uploadGlyph(uint8_t slot, uint8_t id)
+{
+    uint8_t rows[Hd44780Commands::CGRAM_ROWS];
+    memcpy_P(rows, GLYPH_BITMAPS[id], sizeof(rows));
+    lcd.createChar(slot, rows);
+    
+    slotGlyphs[slot] = id;
+    glyphUploads++;
+    // The address counter now points into CGRAM
+    cursorCol = LCDConstants::COLS;
+    
+    // Cells still showing the old glyph now show the new one
+    char code = LCDConstants::GLYPH_CODE_BASE + slot;
+    for (uint8_t row = 0; row < LCDConstants::ROWS; row++)
+    {
+        for (uint8_t col = 0; col < LCDConstants::COLS; col++)
+        {
+            if (shown[row][col] == code)
+            {
+                shown[row][col] = '\0';
+                dirtyCells[row] |= 1u << col;
+            }
+        }
+    }
+}
+
+void LCDDisplay::resetStats()
+{
+    maxQueueDepth = 0;
+    lastDrainMicros = 0;
+    maxDrainMicros = 0;
+    cellsWritten = 0;
+    cursorMoves = 0;
+    glyphUploads = 0;
+}
+
+void LCDDisplay::printDebug() const
+{
+    Serial.print(F("LCDDisplay - Queue: "));
+    Serial.print(getQueueDepth());
+    Serial.print(F(" | Max queue: "));
+    Serial.print(maxQueueDepth);
+    Serial.print(F(" | Drain max: "));
+    Serial.print(maxDrainMicros);
+    Serial.print(F("us | Cells written: "));
+    Serial.print(cellsWritten);
+    Serial.print(F(" | Cursor moves: "));
+    Serial.print(cursorMoves);
+    Serial.print(F(" | Glyph uploads: "));
+    Serial.println(glyphUploads);
+}
+
+Hd44780& LCDDisplay::getLcd()
 {
     return lcd;
 }
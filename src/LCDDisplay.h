@@ -2,13 +2,36 @@
 #define LCD_DISPLAY_H
 
 #include <Arduino.h>
-#include <LiquidCrystal.h>
+#include "Hd44780.h"
 #include "Constants.h"
 
+// Custom characters, bitmaps in PROGMEM (LCDDisplay.cpp)
+enum class LCDGlyph : uint8_t
+{
+    GOLD,
+    HEART,
+    EXPLOSIVE,
+    BOMB,
+    STAR,
+    FLAG,
+    COUNT
+};
+
+// Text output goes into a desired 16x2 buffer; cells that differ from the
+// shadow of what the LCD shows are marked dirty. update(), called once per
+// main loop iteration, sends dirty cells until the per-tick time or transfer
+// budget runs out or the LCD is still busy with the last command, so a full
+// redraw is spread over several iterations instead of stalling input and
+// sound. The cursor only moves where a run of dirty cells breaks. flush()
+// sends everything at once, waiting on the LCD as needed.
+//
+// Glyphs are uploaded to the LCD's 8 CGRAM slots on first use and stay
+// there until the least recently used one has to make room, so redrawing an
+// icon that is already resident costs nothing beyond its cell.
 class LCDDisplay
 {
 public:
-    LCDDisplay(LiquidCrystal& lcdRef);
+    LCDDisplay(Hd44780& lcdRef);
 
     void init();
     void setBrightness(uint8_t brightness);  // 0-255 PWM value
@@ -18,6 +41,12 @@ public:
     void printAt(byte col, byte row, const char* text);
     void printAt(byte col, byte row, const __FlashStringHelper* text);
 
+    // Character code for a glyph, usable in any text (e.g. LCDFormatter).
+    // Loads it into CGRAM first if it isn't resident: those 9 bytes go out
+    // right away, outside update()'s per-tick budget
+    char glyph(LCDGlyph id);
+    void printGlyph(byte col, byte row, LCDGlyph id);
+
     // Print centered text
     void printCentered(byte row, const char* text);
     void printCentered(byte row, const __FlashStringHelper* text);
@@ -29,13 +58,60 @@ public:
     void showMessage(const char* line1, const char* line2);
     void showMessage(const __FlashStringHelper* line1, const __FlashStringHelper* line2);
 
-    // Access to underlying LCD for advanced operations
-    LiquidCrystal& getLcd();
+    // Send changed cells within the per-tick budget (LCDConstants), never
+    // waiting for the LCD to become ready
+    void update();
+    // Send all changed cells now, e.g. before a blocking loop
+    void flush();
+    // Forget what the LCD shows, so the next flush() rewrites every cell
+    void invalidate();
+
+    // Cells still waiting to be sent
+    uint8_t getQueueDepth() const;
+    uint8_t getMaxQueueDepth() const { return maxQueueDepth; }
+    unsigned long getLastDrainMicros() const { return lastDrainMicros; }
+    unsigned long getMaxDrainMicros() const { return maxDrainMicros; }
+    unsigned long getCellsWritten() const { return cellsWritten; }
+    unsigned long getCursorMoves() const { return cursorMoves; }
+    unsigned long getGlyphUploads() const { return glyphUploads; }
+    void resetStats();
+    void printDebug() const;
+
+    // Access to underlying LCD for advanced operations; writes made through
+    // it bypass the shadow buffer, so call invalidate() afterwards
+    Hd44780& getLcd();
 
 private:
-    LiquidCrystal& lcd;
+    Hd44780& lcd;
     uint8_t ledPin;
     uint8_t currentBrightness;
+
+    char desired[LCDConstants::ROWS][LCDConstants::COLS];
+    char shown[LCDConstants::ROWS][LCDConstants::COLS];  // '\0' = unknown
+    uint16_t dirtyCells[LCDConstants::ROWS];             // bit n = column n differs
+    uint8_t cursorCol;  // where the LCD's address counter points
+    uint8_t cursorRow;
+
+    static const uint8_t NO_GLYPH = 0xFF;
+    uint8_t slotGlyphs[Hd44780Commands::CGRAM_SLOTS];  // LCDGlyph in each slot, or NO_GLYPH
+    uint8_t slotOrder[Hd44780Commands::CGRAM_SLOTS];   // slot numbers, most recently used first
+
+    uint8_t maxQueueDepth;
+    unsigned long lastDrainMicros;
+    unsigned long maxDrainMicros;
+    unsigned long cellsWritten;
+    unsigned long cursorMoves;
+    unsigned long glyphUploads;
+
+    void putChar(byte col, byte row, char c);
+    void markRow(byte row);
+    bool nextDirtyCell(uint8_t& col, uint8_t& row) const;
+    void writeCell(uint8_t col, uint8_t row);
+    void drain(uint16_t budgetMicros, uint8_t maxTransfers);
+    void resetGlyphSlots();
+    void touchSlot(uint8_t slot);
+    uint8_t evictSlot() const;
+    void uploadGlyph(uint8_t slot, uint8_t id);
 };
 
 #endif // LCD_DISPLAY_H
@@ -0,0 +1,78 @@
+#include "LCDFormatter.h"
+
+LCDFormatter::LCDFormatter()
+    : length(0)
+{
+    buffer[0] = '\0';
+}
+
+LCDFormatter& LCDFormatter::clear()
+{
+    length = 0;
+    buffer[0] = '\0';
+    return *this;
+}
+
+LCDFormatter& LCDFormatter::character(char c)
+{
+    if (length < LCDConstants::COLS)
+    {
+        buffer[length++] = c;
+        buffer[length] = '\0';
+    }
+    return *this;
+}
+
+LCDFormatter& LCDFormatter::text(const char* str)
+{
+    while (*str && length < LCDConstants::COLS)
+    {
+        buffer[length++] = *str++;
+    }
+    buffer[length] = '\0';
+    return *this;
+}
+
+LCDFormatter& LCDFormatter::text(const __FlashStringHelper* str)
+{
+    const char* p = reinterpret_cast<const char*>(str);
+    char c;
+    while (length < LCDConstants::COLS && (c = pgm_read_byte(p++)) != '\0')
+    {
+        buffer[length++] = c;
+    }
+    buffer[length] = '\0';
+    return *this;
+}
+
+LCDFormatter& LCDFormatter::spaces(uint8_t count)
+{
+    while (count-- > 0)
+    {
+        character(' ');
+    }
+    return *this;
+}
+
+LCDFormatter& LCDFormatter::number(uint16_t value, uint8_t width, char pad)
+{
+    // Digits come out least significant first; 65535 has five
+    char digits[5];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    
+    while (width > count)
+    {
+        character(pad);
+        width--;
+    }
+    while (count > 0)
+    {
+        character(digits[--count]);
+    }
+    return *this;
+}
@@ -0,0 +1,37 @@
+#ifndef LCD_FORMATTER_H
+#define LCD_FORMATTER_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+// Builds one LCD line in a fixed buffer: no sprintf (pulls in vfprintf) and
+// no String (heap). Calls chain, and anything past LCDConstants::COLS is
+// dropped, so the result always fits the display and stays terminated.
+//
+//   LCDFormatter line;
+//   line.text(F("Lives: ")).number(lives);
+//   lcdDisplay.printCentered(1, line.c_str());
+class LCDFormatter
+{
+private:
+    char buffer[LCDConstants::COLS + 1];
+    uint8_t length;
+
+public:
+    LCDFormatter();
+    
+    LCDFormatter& clear();
+    
+    LCDFormatter& text(const char* str);
+    LCDFormatter& text(const __FlashStringHelper* str);
+    LCDFormatter& character(char c);
+    LCDFormatter& spaces(uint8_t count);
+    
+    // Unsigned decimal, right-aligned in at least `width` columns
+    LCDFormatter& number(uint16_t value, uint8_t width = 0, char pad = ' ');
+    
+    const char* c_str() const { return buffer; }
+    uint8_t getLength() const { return length; }
+};
+
+#endif // LCD_FORMATTER_H
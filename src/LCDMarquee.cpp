@@ -0,0 +1,110 @@
+#include "LCDMarquee.h"
+
+LCDMarquee::LCDMarquee(LCDDisplay& lcdDisplay)
+    : display(lcdDisplay)
+    , text(nullptr)
+    , textLength(0)
+    , textPosition(0)
+    , writeColumn(0)
+    , columnsAhead(0)
+    , lastStepTime(0)
+    , scrolling(false)
+    , active(false)
+{
+}
+
+void LCDMarquee::writeNext(Hd44780& lcd)
+{
+    lcd.write(pgm_read_byte(text + textPosition));
+    
+    if (++textPosition == textLength)
+    {
+        textPosition = 0;
+    }
+    if (++writeColumn == LCDConstants::DDRAM_COLS)
+    {
+        // Past column 39 the address counter runs on into row 1
+        writeColumn = 0;
+        lcd.setCursor(0, 0);
+    }
+}
+
+void LCDMarquee::start(const __FlashStringHelper* scrollText, const __FlashStringHelper* hint, unsigned long currentTime)
+{
+    text = reinterpret_cast<const char*>(scrollText);
+    textLength = strlen_P(text);
+    if (textLength == 0)
+    {
+        return;
+    }
+    
+    // Anything still queued would land in a shifted display
+    display.flush();
+    Hd44780& lcd = display.getLcd();
+    
+    textPosition = 0;
+    writeColumn = 0;
+    lcd.setCursor(0, 0);
+    for (uint8_t col = 0; col < LCDConstants::DDRAM_COLS; col++)
+    {
+        writeNext(lcd);
+    }
+    columnsAhead = LCDConstants::DDRAM_COLS - LCDConstants::COLS;
+    
+    const char* hintText = reinterpret_cast<const char*>(hint);
+    uint8_t hintLength = strlen_P(hintText);
+    lcd.setCursor(0, 1);
+    for (uint8_t col = 0; col < LCDConstants::DDRAM_COLS; col++)
+    {
+        uint8_t i = col % LCDConstants::MARQUEE_HINT_PERIOD;
+        lcd.write(i < hintLength ? pgm_read_byte(hintText + i) : ' ');
+    }
+    lcd.setCursor(0, 0);
+    
+    lastStepTime = currentTime;
+    scrolling = false;
+    active = true;
+}
+
+void LCDMarquee::update(unsigned long currentTime)
+{
+    if (!active)
+    {
+        return;
+    }
+    
+    uint16_t interval = scrolling ? TimingConstants::TEXT_SCROLL_INTERVAL_MS
+                                  : TimingConstants::TEXT_SCROLL_START_DELAY_MS;
+    if (currentTime - lastStepTime < interval)
+    {
+        return;
+    }
+    lastStepTime = currentTime;
+    scrolling = true;
+    
+    Hd44780& lcd = display.getLcd();
+    
+    // Once the first 40 columns are used up, the column about to scroll in
+    // is the one that scrolled out 24 steps ago
+    if (columnsAhead == 0)
+    {
+        writeNext(lcd);
+        columnsAhead++;
+    }
+    
+    lcd.command(Hd44780Commands::CURSOR_SHIFT | Hd44780Commands::SHIFT_DISPLAY);
+    columnsAhead--;
+}
+
+void LCDMarquee::stop()
+{
+    if (!active)
+    {
+        return;
+    }
+    active = false;
+    
+    // Undo the shift; the screen no longer matches LCDDisplay's shadow
+    display.getLcd().command(Hd44780Commands::RETURN_HOME);
+    display.invalidate();
+}
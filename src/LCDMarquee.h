@@ -0,0 +1,44 @@
+#ifndef LCD_MARQUEE_H
+#define LCD_MARQUEE_H
+
+#include <Arduino.h>
+#include "LCDDisplay.h"
+#include "Constants.h"
+
+// Scrolls PROGMEM text along row 0 using the HD44780's own display shift.
+// Each row has 40 DDRAM columns of which 16 are visible, so one shift
+// command moves the whole view; the column about to scroll in is refilled
+// from flash just before, one data byte per step (plus a cursor command
+// every 40 steps). No text is copied to RAM, so length is unlimited.
+//
+// The shift moves both rows: row 1 holds the hint repeated every
+// MARQUEE_HINT_PERIOD columns, so it stays readable while scrolling.
+// While running, the marquee owns the LCD; stop() undoes the shift and has
+// LCDDisplay redraw from its buffer.
+class LCDMarquee
+{
+public:
+    LCDMarquee(LCDDisplay& lcdDisplay);
+    
+    void start(const __FlashStringHelper* text, const __FlashStringHelper* hint, unsigned long currentTime);
+    // One step per TEXT_SCROLL_INTERVAL_MS, after TEXT_SCROLL_START_DELAY_MS
+    void update(unsigned long currentTime);
+    void stop();
+    
+    bool isActive() const { return active; }
+
+private:
+    LCDDisplay& display;
+    const char* text;            // PROGMEM
+    uint16_t textLength;
+    uint16_t textPosition;       // next character to write into DDRAM
+    uint8_t writeColumn;         // DDRAM column it goes to
+    uint8_t columnsAhead;        // written columns right of the visible window
+    unsigned long lastStepTime;
+    bool scrolling;              // past the start delay
+    bool active;
+    
+    void writeNext(Hd44780& lcd);
+};
+
+#endif // LCD_MARQUEE_H
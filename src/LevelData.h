@@ -0,0 +1,186 @@
+// Generated by tools/levelc.cpp from levels/*.txt. Do not edit by hand.
+
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+
+#include <Arduino.h>
+#include "Constants.h"
+#include "Levels.h"
+
+// Encoded level layouts (see LevelFormat in Constants.h).
+// A table of room offsets, then the rooms in row-major order.
+// Each room: 8 wall rows, then feature groups, then ROOM_END.
+
+#define LEVEL_DATA_COUNT 6
+
+// levels/level0.txt: 2x2 rooms, 64 bytes, 10 gold, 0 hidden gold
+const uint8_t LEVEL_0_DATA[] PROGMEM = {
+    // Room offsets
+    0x08, 0x00, 0x1A, 0x00, 0x2E, 0x00, 0x37, 0x00,
+    // Room 0
+    0xFF, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 5), 0x12, 0x1C, 0x23, 0x2D, 0x32,
+    LevelFormat::group(TileType::DOOR, 2), 0x1F, 0x27,
+    LevelFormat::ROOM_END,
+    // Room 1
+    0xFF, 0xB1, 0x81, 0x29, 0x25, 0xBF, 0x80, 0xFF,
+    LevelFormat::group(TileType::GOLD, 5), 0x0E, 0x13, 0x15, 0x16, 0x26,
+    LevelFormat::group(TileType::DOOR, 2), 0x18, 0x20,
+    LevelFormat::group(TileType::EXIT, 1), 0x37,
+    LevelFormat::ROOM_END,
+    // Room 2
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    LevelFormat::ROOM_END,
+    // Room 3
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    LevelFormat::ROOM_END,
+};
+
+// levels/level1.txt: 2x2 rooms, 61 bytes, 7 gold, 0 hidden gold
+const uint8_t LEVEL_1_DATA[] PROGMEM = {
+    // Room offsets
+    0x08, 0x00, 0x18, 0x00, 0x2B, 0x00, 0x34, 0x00,
+    // Room 0
+    0xFF, 0x81, 0x81, 0x98, 0x80, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 3), 0x12, 0x2A, 0x34,
+    LevelFormat::group(TileType::DOOR, 2), 0x1F, 0x27,
+    LevelFormat::ROOM_END,
+    // Room 1
+    0xFF, 0x81, 0x80, 0x01, 0x01, 0x8D, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 4), 0x11, 0x1B, 0x25, 0x2A,
+    LevelFormat::group(TileType::DOOR, 2), 0x18, 0x20,
+    LevelFormat::group(TileType::EXIT, 1), 0x17,
+    LevelFormat::ROOM_END,
+    // Room 2
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF,
+    LevelFormat::ROOM_END,
+    // Room 3
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF,
+    LevelFormat::ROOM_END,
+};
+
+// levels/level2.txt: 2x2 rooms, 70 bytes, 10 gold, 0 hidden gold
+const uint8_t LEVEL_2_DATA[] PROGMEM = {
+    // Room offsets
+    0x08, 0x00, 0x1A, 0x00, 0x2A, 0x00, 0x3D, 0x00,
+    // Room 0
+    0xFF, 0x81, 0x88, 0x80, 0x81, 0x81, 0x81, 0xE7,
+    LevelFormat::group(TileType::GOLD, 3), 0x12, 0x23, 0x2D,
+    LevelFormat::group(TileType::DOOR, 4), 0x17, 0x1F, 0x3B, 0x3C,
+    LevelFormat::ROOM_END,
+    // Room 1
+    0xFF, 0x81, 0x09, 0x01, 0x81, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 3), 0x11, 0x22, 0x2D,
+    LevelFormat::group(TileType::DOOR, 2), 0x10, 0x18,
+    LevelFormat::ROOM_END,
+    // Room 2
+    0xE7, 0x81, 0x81, 0x81, 0x89, 0x81, 0x81, 0xEF,
+    LevelFormat::group(TileType::GOLD, 4), 0x13, 0x1D, 0x22, 0x36,
+    LevelFormat::group(TileType::DOOR, 2), 0x03, 0x04,
+    LevelFormat::group(TileType::EXIT, 1), 0x3B,
+    LevelFormat::ROOM_END,
+    // Room 3
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    LevelFormat::ROOM_END,
+};
+
+// levels/level3.txt: 2x2 rooms, 89 bytes, 12 gold, 4 hidden gold
+const uint8_t LEVEL_3_DATA[] PROGMEM = {
+    // Room offsets
+    0x08, 0x00, 0x1C, 0x00, 0x30, 0x00, 0x43, 0x00,
+    // Room 0
+    0xFF, 0x81, 0x80, 0x80, 0x81, 0x81, 0x81, 0xE7,
+    LevelFormat::group(TileType::GOLD, 5), 0x12, 0x1B, 0x1D, 0x2A, 0x34,
+    LevelFormat::group(TileType::DOOR, 4), 0x17, 0x1F, 0x3B, 0x3C,
+    LevelFormat::ROOM_END,
+    // Room 1
+    0xFF, 0x81, 0x0F, 0x0B, 0x8F, 0x81, 0x81, 0xE7,
+    LevelFormat::group(TileType::GOLD, 3), 0x12, 0x21, 0x2D,
+    LevelFormat::group(TileType::DOOR, 4), 0x10, 0x18, 0x3B, 0x3C,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x1D,
+    LevelFormat::ROOM_END,
+    // Room 2
+    0xE7, 0x81, 0x81, 0xF0, 0xDC, 0xF5, 0x95, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x12, 0x1C,
+    LevelFormat::group(TileType::DOOR, 4), 0x03, 0x04, 0x1F, 0x27,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x2C,
+    LevelFormat::ROOM_END,
+    // Room 3
+    0xE7, 0x81, 0x87, 0x05, 0x0F, 0xBC, 0xA9, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x13, 0x21,
+    LevelFormat::group(TileType::DOOR, 4), 0x03, 0x04, 0x18, 0x20,
+    LevelFormat::group(TileType::EXIT, 1), 0x2F,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 2), 0x1E, 0x33,
+    LevelFormat::ROOM_END,
+};
+
+// levels/level4.txt: 3x3 rooms, 178 bytes, 17 gold, 5 hidden gold
+const uint8_t LEVEL_4_DATA[] PROGMEM = {
+    // Room offsets
+    0x12, 0x00, 0x21, 0x00, 0x34, 0x00, 0x45, 0x00, 0x58, 0x00, 0x6B, 0x00, 0x7C, 0x00, 0x8D, 0x00,
+    0xA0, 0x00,
+    // Room 0
+    0xFF, 0x81, 0x81, 0x88, 0x88, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x13, 0x2D,
+    LevelFormat::group(TileType::DOOR, 2), 0x1F, 0x27,
+    LevelFormat::ROOM_END,
+    // Room 1
+    0xFF, 0x81, 0x80, 0x00, 0x29, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x0B, 0x2D,
+    LevelFormat::group(TileType::DOOR, 4), 0x17, 0x18, 0x1F, 0x20,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x23,
+    LevelFormat::ROOM_END,
+    // Room 2
+    0xFF, 0x81, 0x01, 0x01, 0x85, 0x85, 0x81, 0xE7,
+    LevelFormat::group(TileType::GOLD, 2), 0x15, 0x22,
+    LevelFormat::group(TileType::DOOR, 4), 0x10, 0x18, 0x3B, 0x3C,
+    LevelFormat::ROOM_END,
+    // Room 3
+    0xFF, 0x81, 0x88, 0x88, 0x81, 0x81, 0x81, 0xE7,
+    LevelFormat::group(TileType::GOLD, 2), 0x0A, 0x2D,
+    LevelFormat::group(TileType::DOOR, 4), 0x17, 0x1F, 0x3B, 0x3C,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x1B,
+    LevelFormat::ROOM_END,
+    // Room 4
+    0xFF, 0x81, 0x01, 0x01, 0x90, 0x80, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x14, 0x32,
+    LevelFormat::group(TileType::DOOR, 4), 0x10, 0x18, 0x27, 0x2F,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x24,
+    LevelFormat::ROOM_END,
+    // Room 5
+    0xE7, 0x81, 0x81, 0x81, 0x01, 0x01, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x1C, 0x2A,
+    LevelFormat::group(TileType::DOOR, 4), 0x03, 0x04, 0x20, 0x28,
+    LevelFormat::ROOM_END,
+    // Room 6
+    0xE7, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x22, 0x34,
+    LevelFormat::group(TileType::DOOR, 4), 0x03, 0x04, 0x1F, 0x27,
+    LevelFormat::ROOM_END,
+    // Room 7
+    0xFF, 0x81, 0x81, 0x09, 0x00, 0x88, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 2), 0x13, 0x35,
+    LevelFormat::group(TileType::DOOR, 4), 0x18, 0x20, 0x27, 0x2F,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x24,
+    LevelFormat::ROOM_END,
+    // Room 8
+    0xFF, 0x81, 0x81, 0x81, 0x01, 0x1C, 0x81, 0xFF,
+    LevelFormat::group(TileType::GOLD, 1), 0x1C,
+    LevelFormat::group(TileType::DOOR, 2), 0x20, 0x28,
+    LevelFormat::group(TileType::EXIT, 1), 0x2F,
+    LevelFormat::group(TileType::HIDDEN_GOLD, 1), 0x35,
+    LevelFormat::ROOM_END,
+};
+static_assert(36 <= MapConstants::DELTA_LOG_SIZE, "levels/level4.txt can change 36 tiles, more than Map's delta log holds");
+
+const LevelDescriptor LEVELS[MapConstants::LEVEL_COUNT] PROGMEM = {
+    // layout, rooms wide/high, spawn x/y, min/max bombs, explosives, score multiplier (x10), flags, gold, hidden gold
+    { LEVEL_0_DATA, 2, 2, 1, 1, 0, 0, 0, 10, LevelFlags::NONE, 10, 0 },
+    { LEVEL_1_DATA, 2, 2, 1, 1, 2, 4, 0, 15, LevelFlags::NONE, 7, 0 },
+    { LEVEL_2_DATA, 2, 2, 1, 1, 4, 6, 8, 20, LevelFlags::REFILL_EXPLOSIVES, 10, 0 },
+    { LEVEL_3_DATA, 2, 2, 1, 1, 6, 8, 8, 30, LevelFlags::REFILL_EXPLOSIVES | LevelFlags::EXPLOSIVE_BONUS, 12, 4 },
+    { LEVEL_4_DATA, 3, 3, 1, 1, 0, 0, 8, 35, LevelFlags::EXPLOSIVE_BONUS, 17, 5 },
+    { nullptr, 2, 2, 1, 1, 6, 8, 8, 40, LevelFlags::REFILL_EXPLOSIVES | LevelFlags::EXPLOSIVE_BONUS | LevelFlags::PROCEDURAL, 0, 0 },
+};
+
+#endif // LEVEL_DATA_H
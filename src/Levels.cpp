@@ -0,0 +1,13 @@
+#include "Levels.h"
+#include "LevelData.h"
+
+static_assert(LEVEL_DATA_COUNT == MapConstants::LEVEL_COUNT,
+              "LevelData.h level count does not match MapConstants::LEVEL_COUNT");
+
+void getLevelDescriptor(uint8_t level, LevelDescriptor& out)
+{
+    if (level >= MapConstants::LEVEL_COUNT) {
+        level = MapConstants::LEVEL_0;
+    }
+    memcpy_P(&out, &LEVELS[level], sizeof(LevelDescriptor));
+}
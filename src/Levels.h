@@ -0,0 +1,31 @@
+#ifndef LEVELS_H
+#define LEVELS_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+// One entry of the level table. The table is generated into LevelData.h by
+// tools/levelc.cpp from levels/*.txt. Bomb counts are for NORMAL difficulty;
+// GameSettings shifts them for the other difficulties.
+struct LevelDescriptor
+{
+    const uint8_t* layout;     // PROGMEM, LevelFormat encoded; nullptr for PROCEDURAL levels
+    uint8_t roomsWide;         // world size in rooms; more than 2 per side is paged
+    uint8_t roomsHigh;
+    uint8_t spawnX;
+    uint8_t spawnY;
+    uint8_t minBombs;
+    uint8_t maxBombs;          // 0 = no random bombs on this level
+    uint8_t explosives;        // granted when the run starts here (or on entry with REFILL_EXPLOSIVES)
+    uint8_t scoreMultTenths;   // starting-level score multiplier, 10 = 1.0x
+    uint8_t flags;             // LevelFlags
+    uint8_t goldCount;         // visible gold in the layout
+    uint8_t hiddenGoldCount;   // gold hidden in walls
+};
+
+extern const LevelDescriptor LEVELS[MapConstants::LEVEL_COUNT] PROGMEM;
+
+// Copies the descriptor into RAM; out-of-range levels fall back to level 0
+void getLevelDescriptor(uint8_t level, LevelDescriptor& out);
+
+#endif // LEVELS_H
@@ -1,116 +1,177 @@
 #include "Map.h"
 #include "GameSettings.h"
-
-constexpr uint8_t E = static_cast<uint8_t>(TileType::EMPTY);
-constexpr uint8_t W = static_cast<uint8_t>(TileType::WALL);
-constexpr uint8_t G = static_cast<uint8_t>(TileType::GOLD);
-constexpr uint8_t D = static_cast<uint8_t>(TileType::DOOR);
-constexpr uint8_t B = static_cast<uint8_t>(TileType::BOMB);
-constexpr uint8_t X = static_cast<uint8_t>(TileType::EXIT);
-constexpr uint8_t H = static_cast<uint8_t>(TileType::HIDDEN_GOLD);
-
-const uint8_t LEVEL_0_LAYOUT[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE] PROGMEM = {
-    /*0*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},
-    /*1*/ {W, E, E, E, E, E, E, W, W, E, W, W, E, E, G, W},
-    /*2*/ {W, E, G, E, E, E, E, W, W, E, E, G, E, G, G, W},
-    /*3*/ {W, E, E, E, G, E, E, D, D, E, W, E, W, E, E, W},
-    /*4*/ {W, E, E, G, E, E, E, D, D, E, W, E, E, W, G, W},
-    /*5*/ {W, E, E, E, E, G, E, W, W, E, W, W, W, W, W, W},
-    /*6*/ {W, E, G, E, E, E, E, W, W, E, E, E, E, E, E, X},
-    /*7*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*8*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W}, 
-    /*9*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*10*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W}, 
-    /*11*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*12*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*13*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*14*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},  
-    /*15*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W}   
-};
-
-const uint8_t LEVEL_1_LAYOUT[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE] PROGMEM = {
-    /*0*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},
-    /*1*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*2*/ {W, E, G, E, E, E, E, W, W, G, E, E, E, E, E, X},
-    /*3*/ {W, E, E, W, W, E, E, D, D, E, E, G, E, E, E, W},
-    /*4*/ {W, E, E, E, E, E, E, D, D, E, E, E, E, G, E, W},
-    /*5*/ {W, E, G, E, E, E, E, W, W, E, G, E, W, W, E, W},
-    /*6*/ {W, E, E, E, G, E, E, W, W, E, E, E, E, E, E, W},
-    /*7*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},
-    /*8*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*9*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*10*/{W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*11*/{W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*12*/{W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*13*/{W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*14*/{W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*15*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W}
-};
-
-const uint8_t LEVEL_2_LAYOUT[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE] PROGMEM = {
-    /*0*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},
-    /*1*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*2*/ {W, E, G, E, W, E, E, D, D, G, E, E, W, E, E, W},
-    /*3*/ {W, E, E, E, E, E, E, D, D, E, E, E, E, E, E, W},
-    /*4*/ {W, E, E, G, E, E, E, W, W, E, G, E, E, E, E, W},
-    /*5*/ {W, E, E, E, E, G, E, W, W, E, E, E, E, G, E, W},
-    /*6*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*7*/ {W, W, W, D, D, W, W, W, W, W, W, W, W, W, W, W},
-    /*8*/ {W, W, W, D, D, W, W, W, W, W, W, W, W, W, W, W},
-    /*9*/ {W, E, E, E, E, E, E, W, W, W, W, W, W, W, W, W},
-    /*10*/{W, E, E, G, E, E, E, W, W, W, W, W, W, W, W, W},
-    /*11*/{W, E, E, E, E, G, E, W, W, W, W, W, W, W, W, W},
-    /*12*/{W, E, G, E, W, E, E, W, W, W, W, W, W, W, W, W},
-    /*13*/{W, E, E, E, E, E, E, W, W, W, W, W, W, W, W, W},
-    /*14*/{W, E, E, E, E, E, G, W, W, W, W, W, W, W, W, W},
-    /*15*/{W, W, W, X, W, W, W, W, W, W, W, W, W, W, W, W}
-};
-
-const uint8_t LEVEL_3_LAYOUT[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE] PROGMEM = {
-    /*0*/ {W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W},
-    /*1*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*2*/ {W, E, G, E, E, E, E, D, D, E, G, E, W, W, W, W},
-    /*3*/ {W, E, E, G, E, G, E, D, D, E, E, E, W, H, W, W},
-    /*4*/ {W, E, E, E, E, E, E, W, W, G, E, E, W, W, W, W},
-    /*5*/ {W, E, G, E, E, E, E, W, W, E, E, E, E, G, E, W},
-    /*6*/ {W, E, E, E, G, E, E, W, W, E, E, E, E, E, E, W},
-    /*7*/ {W, W, W, D, D, W, W, W, W, W, W, D, D, W, W, W},
-    /*8*/ {W, W, W, D, D, W, W, W, W, W, W, D, D, W, W, W},
-    /*9*/ {W, E, E, E, E, E, E, W, W, E, E, E, E, E, E, W},
-    /*10*/{W, E, G, E, E, E, E, W, W, E, E, G, E, W, W, W},
-    /*11*/{W, W, W, W, G, E, E, D, D, E, E, E, E, W, H, W},
-    /*12*/{W, W, E, W, W, W, E, D, D, G, E, E, W, W, W, W},
-    /*13*/{W, W, W, W, H, W, E, W, W, E, W, W, W, W, E, X},
-    /*14*/{W, E, E, W, E, W, E, W, W, E, W, H, W, E, E, W},
-    /*15*/{W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W}
-};
+#include "Levels.h"
+#include "FastRandom.h"
 
 Map::Map()
-    : currentLevel{0},
-      totalGoldCount{0}
+    : layoutData{nullptr},
+      roomsWide{MapConstants::ROOMS_PER_ROW},
+      roomsHigh{MapConstants::ROOMS_PER_ROW},
+      windowRoomX{0},
+      windowRoomY{0},
+      deltaCount{0},
+      deltaOverflows{0},
+      currentLevel{0},
+      totalGoldCount{0},
+      spawnX{SpawnConstants::DEFAULT_SPAWN_X},
+      spawnY{SpawnConstants::DEFAULT_SPAWN_Y},
+      levelSeed{0},
+      exitX{0},
+      exitY{0},
+      canBlastWalls{false},
+      lastLoadMicros{0},
+      lastPlacementAttempts{0},
+      lastPageMicros{0},
+      pageCount{0}
 {
     clearMap();
 }
 
 void Map::clearMap()
 {
+    // EMPTY is 0, so this is valid for both storage layouts
     memset(mapData, static_cast<uint8_t>(TileType::EMPTY), sizeof(mapData));
+    memset(tilePlanes, 0, sizeof(tilePlanes));
+    memset(treasureProximity, 0, sizeof(treasureProximity));
+}
+
+// Unchecked storage access; callers validate coordinates
+TileType Map::readTile(uint8_t x, uint8_t y) const
+{
+#if MAP_PACKED_TILES
+    uint8_t packed = mapData[y][x >> 1];
+    return static_cast<TileType>((x & 1) ? (packed >> 4) : (packed & 0x0F));
+#else
+    return static_cast<TileType>(mapData[y][x]);
+#endif
+}
+
+void Map::writeTile(uint8_t x, uint8_t y, TileType type)
+{
+#if MAP_PACKED_TILES
+    uint8_t& packed = mapData[y][x >> 1];
+    uint8_t value = static_cast<uint8_t>(type) & 0x0F;
+    
+    if (x & 1) {
+        packed = (packed & 0x0F) | (value << 4);
+    } else {
+        packed = (packed & 0xF0) | value;
+    }
+#else
+    mapData[y][x] = static_cast<uint8_t>(type);
+#endif
+}
+
+TilePlane Map::planeForTile(TileType tile)
+{
+    switch (tile) {
+        case TileType::WALL:        return TilePlane::WALL;
+        case TileType::GOLD:        return TilePlane::GOLD;
+        case TileType::BOMB:        return TilePlane::BOMB;
+        case TileType::HIDDEN_GOLD: return TilePlane::HIDDEN_GOLD;
+        default:                    return TilePlane::NONE;
+    }
+}
+
+void Map::updatePlaneBit(TilePlane plane, uint8_t x, uint8_t y, bool set)
+{
+    uint8_t& row = tilePlanes[static_cast<uint8_t>(plane)][getRoomIndex(x, y)][y % MapConstants::ROOM_SIZE];
+    uint8_t mask = MatrixConstants::ROW_MSB >> (x % MapConstants::ROOM_SIZE);
+    
+    if (set) {
+        row |= mask;
+    } else {
+        row &= ~mask;
+    }
+}
+
+bool Map::testPlaneBit(TilePlane plane, uint8_t x, uint8_t y) const
+{
+    uint8_t row = tilePlanes[static_cast<uint8_t>(plane)][getRoomIndex(x, y)][y % MapConstants::ROOM_SIZE];
+    return row & (MatrixConstants::ROW_MSB >> (x % MapConstants::ROOM_SIZE));
+}
+
+const uint8_t* Map::getRoomPlane(TilePlane plane, uint8_t roomOriginX, uint8_t roomOriginY) const
+{
+    static const uint8_t EMPTY_ROOM[MapConstants::ROOM_SIZE] = {0};
+    
+    uint8_t localX, localY;
+    if (!toLocal(roomOriginX, roomOriginY, localX, localY)) {
+        return EMPTY_ROOM;
+    }
+    return tilePlanes[static_cast<uint8_t>(plane)][getRoomIndex(localX, localY)];
+}
+
+uint16_t Map::getPlaneRow(TilePlane plane, uint8_t y) const
+{
+    const uint8_t (*rooms)[MapConstants::ROOM_SIZE] = tilePlanes[static_cast<uint8_t>(plane)];
+    uint8_t roomRow = (y / MapConstants::ROOM_SIZE) * MapConstants::ROOMS_PER_ROW;
+    uint8_t localY = y % MapConstants::ROOM_SIZE;
+    
+    return (static_cast<uint16_t>(rooms[roomRow][localY]) << 8) | rooms[roomRow + 1][localY];
 }
 
+// Rebuilds rows minY..maxY of the hidden-gold proximity mask: each row is the
+// OR of the hidden-gold rows within the detection radius, smeared sideways
+// by the same radius.
+void Map::updateTreasureProximity(uint8_t minY, uint8_t maxY)
+{
+    const uint8_t radius = GameplayConstants::TREASURE_DETECTION_RADIUS;
+    
+    for (uint8_t row = minY; row <= maxY; row++) {
+        uint8_t first = row > radius ? row - radius : 0;
+        uint8_t last = row + radius < MapConstants::WORLD_SIZE ? row + radius : MapConstants::WORLD_SIZE - 1;
+        
+        uint16_t hidden = 0;
+        for (uint8_t y = first; y <= last; y++) {
+            hidden |= getPlaneRow(TilePlane::HIDDEN_GOLD, y);
+        }
+        
+        uint16_t near = hidden;
+        for (uint8_t shift = 1; shift <= radius; shift++) {
+            near |= (hidden << shift) | (hidden >> shift);
+        }
+        treasureProximity[row] = near;
+    }
+}
+
+bool Map::isNearHiddenGold(uint8_t x, uint8_t y) const
+{
+    uint8_t localX, localY;
+    if (!toLocal(x, y, localX, localY)) {
+        return false;
+    }
+    return treasureProximity[localY] & (0x8000u >> localX);
+}
+
+// World to window coordinates; false outside the resident window
+bool Map::toLocal(uint8_t x, uint8_t y, uint8_t& localX, uint8_t& localY) const
+{
+    // Unsigned wrap-around turns "left of / above the window" into large values
+    localX = x - windowRoomX * MapConstants::ROOM_SIZE;
+    localY = y - windowRoomY * MapConstants::ROOM_SIZE;
+    return localX < MapConstants::WORLD_SIZE && localY < MapConstants::WORLD_SIZE
+        && isInBounds(x, y);
+}
 
 TileType Map::getTile(uint8_t x, uint8_t y) const
 {
-    if (x >= MapConstants::WORLD_SIZE || y >= MapConstants::WORLD_SIZE) {
-        return TileType::WALL;
+    uint8_t localX, localY;
+    if (toLocal(x, y, localX, localY)) {
+        return readTile(localX, localY);
     }
     
-    return static_cast<TileType>(mapData[y][x]);
+    return isInBounds(x, y) ? readPagedOutTile(x, y) : TileType::WALL;
 }
 
 bool Map::isSolid(uint8_t x, uint8_t y) const
 {
-    TileType tile = getTile(x, y);
-    return (tile == TileType::WALL || tile == TileType::HIDDEN_GOLD);
+    uint8_t localX, localY;
+    if (!toLocal(x, y, localX, localY)) {
+        return true;
+    }
+    
+    return testPlaneBit(TilePlane::WALL, localX, localY) || testPlaneBit(TilePlane::HIDDEN_GOLD, localX, localY);
 }
 
 bool Map::isWalkable(uint8_t x, uint8_t y) const
@@ -120,7 +181,7 @@ bool Map::isWalkable(uint8_t x, uint8_t y) const
 
 bool Map::isInBounds(uint8_t x, uint8_t y) const
 {
-    return (x < MapConstants::WORLD_SIZE && y < MapConstants::WORLD_SIZE);
+    return (x < getWorldWidth() && y < getWorldHeight());
 }
 
 void Map::setTile(uint8_t x, uint8_t y, TileType type)
@@ -129,7 +190,111 @@ void Map::setTile(uint8_t x, uint8_t y, TileType type)
         return;
     }
     
-    mapData[y][x] = static_cast<uint8_t>(type);
+    uint8_t localX, localY;
+    bool resident = toLocal(x, y, localX, localY);
+    TileType oldType = resident ? readTile(localX, localY) : readPagedOutTile(x, y);
+    if (oldType == type) {
+        return;  // e.g. a blast over empty tiles; nothing to log
+    }
+    
+    // Gold uncovered by an explosion joins the level total
+    if (oldType == TileType::HIDDEN_GOLD && type == TileType::GOLD) {
+        totalGoldCount++;
+    }
+    
+    if (isPaged()) {
+        recordDelta(x, y, type);
+    }
+    if (!resident) {
+        return;  // replayed from the log when the room is paged in
+    }
+    
+    setLocalTile(localX, localY, type);
+    
+    // Only rows within the detection radius can see this tile
+    if (oldType == TileType::HIDDEN_GOLD || type == TileType::HIDDEN_GOLD) {
+        const uint8_t radius = GameplayConstants::TREASURE_DETECTION_RADIUS;
+        updateTreasureProximity(localY > radius ? localY - radius : 0,
+                                localY + radius < MapConstants::WORLD_SIZE ? localY + radius : MapConstants::WORLD_SIZE - 1);
+    }
+}
+
+// Tile and bitplanes only, window coordinates
+void Map::setLocalTile(uint8_t x, uint8_t y, TileType type)
+{
+    TilePlane oldPlane = planeForTile(readTile(x, y));
+    if (oldPlane != TilePlane::NONE) {
+        updatePlaneBit(oldPlane, x, y, false);
+    }
+    
+    writeTile(x, y, type);
+    
+    TilePlane newPlane = planeForTile(type);
+    if (newPlane != TilePlane::NONE) {
+        updatePlaneBit(newPlane, x, y, true);
+    }
+}
+
+void Map::recordDelta(uint8_t x, uint8_t y, TileType type)
+{
+    uint8_t room = (y / MapConstants::ROOM_SIZE) * roomsWide + (x / MapConstants::ROOM_SIZE);
+    uint8_t pos = ((y % MapConstants::ROOM_SIZE) << LevelFormat::POS_Y_SHIFT) | (x % MapConstants::ROOM_SIZE);
+    
+    for (uint8_t i = 0; i < deltaCount; i++) {
+        if (deltaLog[i].room == room && deltaLog[i].pos == pos) {
+            deltaLog[i].type = type;
+            return;
+        }
+    }
+    
+    if (deltaCount < MapConstants::DELTA_LOG_SIZE) {
+        deltaLog[deltaCount].room = room;
+        deltaLog[deltaCount].pos = pos;
+        deltaLog[deltaCount].type = type;
+        deltaCount++;
+    } else {
+        deltaOverflows++;  // change is lost once the room is (or if it already is) paged out
+    }
+}
+
+// Current tile of a room outside the window: its logged change if any,
+// otherwise the layout in flash. Paged worlds only.
+TileType Map::readPagedOutTile(uint8_t x, uint8_t y) const
+{
+    uint8_t room = (y / MapConstants::ROOM_SIZE) * roomsWide + (x / MapConstants::ROOM_SIZE);
+    uint8_t localX = x % MapConstants::ROOM_SIZE;
+    uint8_t localY = y % MapConstants::ROOM_SIZE;
+    uint8_t pos = (localY << LevelFormat::POS_Y_SHIFT) | localX;
+    
+    for (uint8_t i = 0; i < deltaCount; i++) {
+        if (deltaLog[i].room == room && deltaLog[i].pos == pos) {
+            return deltaLog[i].type;
+        }
+    }
+    
+    const uint8_t* offsetEntry = layoutData + room * LevelFormat::OFFSET_BYTES;
+    uint16_t offset = pgm_read_byte(offsetEntry) | (static_cast<uint16_t>(pgm_read_byte(offsetEntry + 1)) << 8);
+    const uint8_t* cursor = layoutData + offset;
+    
+    if (pgm_read_byte(cursor + localY) & (MatrixConstants::ROW_MSB >> localX)) {
+        return TileType::WALL;
+    }
+    cursor += MapConstants::ROOM_SIZE;
+    
+    uint8_t header = pgm_read_byte(cursor++);
+    while (header != LevelFormat::ROOM_END)
+    {
+        uint8_t count = header & LevelFormat::COUNT_MASK;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (pgm_read_byte(cursor++) == pos) {
+                return static_cast<TileType>(header >> LevelFormat::TYPE_SHIFT);
+            }
+        }
+        header = pgm_read_byte(cursor++);
+    }
+    
+    return TileType::EMPTY;
 }
 
 void Map::collectGold(uint8_t x, uint8_t y)
@@ -139,117 +304,503 @@ void Map::collectGold(uint8_t x, uint8_t y)
     }
 }
 
-void Map::loadLayoutFromArray(const uint8_t layout[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE])
+void Map::placeTile(uint8_t x, uint8_t y, TileType type)
 {
-    for (uint8_t y = 0; y < MapConstants::WORLD_SIZE; y++) {
-        for (uint8_t x = 0; x < MapConstants::WORLD_SIZE; x++) {
-            mapData[y][x] = pgm_read_byte(&layout[y][x]);
-        }
+    // Only valid on a cleared room: nothing to remove from the planes
+    writeTile(x, y, type);
+    
+    if (type == TileType::EXIT) {
+        exitX = x;
+        exitY = y;
+    }
+    
+    TilePlane plane = planeForTile(type);
+    if (plane != TilePlane::NONE) {
+        updatePlaneBit(plane, x, y, true);
     }
 }
 
-
-void Map::loadLevel(uint8_t level, GameSettings* settings)
+void Map::pageIn(uint8_t x, uint8_t y)
 {
-    currentLevel = level;
+    if (!isInBounds(x, y)) {
+        return;
+    }
     
-    clearMap();
+    uint8_t roomX = x / MapConstants::ROOM_SIZE;
+    uint8_t roomY = y / MapConstants::ROOM_SIZE;
+    uint8_t newWindowX = windowRoomX;
+    uint8_t newWindowY = windowRoomY;
+    
+    // Slide by one room so the target room becomes resident next to the
+    // one the player is leaving
+    if (roomX < newWindowX) {
+        newWindowX = roomX;
+    } else if (roomX >= newWindowX + MapConstants::ROOMS_PER_ROW) {
+        newWindowX = roomX - (MapConstants::ROOMS_PER_ROW - 1);
+    }
+    if (roomY < newWindowY) {
+        newWindowY = roomY;
+    } else if (roomY >= newWindowY + MapConstants::ROOMS_PER_ROW) {
+        newWindowY = roomY - (MapConstants::ROOMS_PER_ROW - 1);
+    }
+    
+    if (newWindowX != windowRoomX || newWindowY != windowRoomY) {
+        pageWindow(newWindowX, newWindowY);
+    }
+}
 
-    switch (level)
+// Decodes the 2x2 rooms starting at world room (roomX, roomY) from flash and
+// replays their logged changes
+void Map::pageWindow(uint8_t roomX, uint8_t roomY)
+{
+    unsigned long pageStart = micros();
+    
+    windowRoomX = roomX;
+    windowRoomY = roomY;
+    
+    for (uint8_t slot = 0; slot < MapConstants::ROOM_COUNT; slot++)
     {
-        case MapConstants::LEVEL_0:
-            createLevel0();
-            break;
-        case MapConstants::LEVEL_1:
-            if (settings) {
-                createLevel1(settings->getMinBombsForLevel(level), 
-                           settings->getMaxBombsForLevel(level));
-            } else {
-                createLevel1(2, 4);
-            }
-            break;
-        case MapConstants::LEVEL_2:
-            if (settings) {
-                createLevel2(settings->getMinBombsForLevel(level), 
-                           settings->getMaxBombsForLevel(level));
-            } else {
-                createLevel2(4, 6);
-            }
-            break;
-        case MapConstants::LEVEL_3:
-            if (settings) {
-                createLevel3(settings->getMinBombsForLevel(level), 
-                           settings->getMaxBombsForLevel(level));
-            } else {
-                createLevel3(6, 8);
+        uint8_t worldRoom = (roomY + slot / MapConstants::ROOMS_PER_ROW) * roomsWide
+                          + roomX + slot % MapConstants::ROOMS_PER_ROW;
+        uint8_t originX = (slot % MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+        uint8_t originY = (slot / MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+        
+        clearRoomSlot(slot);
+        decodeRoom(worldRoom, slot);
+        
+        for (uint8_t i = 0; i < deltaCount; i++) {
+            if (deltaLog[i].room == worldRoom) {
+                uint8_t pos = deltaLog[i].pos;
+                setLocalTile(originX + (pos & LevelFormat::POS_X_MASK),
+                             originY + (pos >> LevelFormat::POS_Y_SHIFT),
+                             deltaLog[i].type);
             }
-            break;
-        default:
-            createLevel0();
-            break;
+        }
     }
     
-    totalGoldCount = 0;
-    for (uint8_t y = 0; y < MapConstants::WORLD_SIZE; y++) {
-        for (uint8_t x = 0; x < MapConstants::WORLD_SIZE; x++) {
-            if (getTile(x, y) == TileType::GOLD) {
-                totalGoldCount++;
+    updateTreasureProximity(0, MapConstants::WORLD_SIZE - 1);
+    
+    pageCount++;
+    lastPageMicros = micros() - pageStart;
+}
+
+void Map::clearRoomSlot(uint8_t slot)
+{
+    const uint8_t rowBytes = sizeof(mapData[0]) / MapConstants::ROOMS_PER_ROW;
+    uint8_t originX = (slot % MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+    uint8_t originY = (slot / MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+    
+    for (uint8_t y = originY; y < originY + MapConstants::ROOM_SIZE; y++) {
+        memset(&mapData[y][(originX / MapConstants::ROOM_SIZE) * rowBytes], static_cast<uint8_t>(TileType::EMPTY), rowBytes);
+    }
+    for (uint8_t plane = 0; plane < static_cast<uint8_t>(TilePlane::COUNT); plane++) {
+        memset(tilePlanes[plane][slot], 0, MapConstants::ROOM_SIZE);
+    }
+}
+
+// Expects a cleared slot
+void Map::decodeRoom(uint8_t worldRoom, uint8_t slot)
+{
+    uint8_t originX = (slot % MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+    uint8_t originY = (slot / MapConstants::ROOMS_PER_ROW) * MapConstants::ROOM_SIZE;
+    uint8_t* wallRows = tilePlanes[static_cast<uint8_t>(TilePlane::WALL)][slot];
+    
+    const uint8_t* offsetEntry = layoutData + worldRoom * LevelFormat::OFFSET_BYTES;
+    uint16_t offset = pgm_read_byte(offsetEntry) | (static_cast<uint16_t>(pgm_read_byte(offsetEntry + 1)) << 8);
+    const uint8_t* cursor = layoutData + offset;
+    
+    // Wall rows go to the wall plane as-is and are expanded into tiles
+    for (uint8_t localY = 0; localY < MapConstants::ROOM_SIZE; localY++)
+    {
+        uint8_t rowBits = pgm_read_byte(cursor++);
+        wallRows[localY] = rowBits;
+        
+        for (uint8_t localX = 0; localX < MapConstants::ROOM_SIZE; localX++)
+        {
+            if (rowBits & (MatrixConstants::ROW_MSB >> localX)) {
+                writeTile(originX + localX, originY + localY, TileType::WALL);
             }
         }
     }
+    
+    // Sparse features: runs of positions sharing one tile type
+    uint8_t header = pgm_read_byte(cursor++);
+    while (header != LevelFormat::ROOM_END)
+    {
+        TileType type = static_cast<TileType>(header >> LevelFormat::TYPE_SHIFT);
+        uint8_t count = header & LevelFormat::COUNT_MASK;
+        
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint8_t pos = pgm_read_byte(cursor++);
+            placeTile(originX + (pos & LevelFormat::POS_X_MASK),
+                      originY + (pos >> LevelFormat::POS_Y_SHIFT),
+                      type);
+        }
+        
+        header = pgm_read_byte(cursor++);
+    }
 }
 
-void Map::createLevel0()
+void Map::loadLevel(uint8_t level, GameSettings* settings, uint8_t explosives)
 {
-    loadLayoutFromArray(LEVEL_0_LAYOUT);
+    unsigned long loadStart = micros();
+    
+    LevelDescriptor descriptor;
+    getLevelDescriptor(level, descriptor);
+    
+    currentLevel = level < MapConstants::LEVEL_COUNT ? level : MapConstants::LEVEL_0;
+    spawnX = descriptor.spawnX;
+    spawnY = descriptor.spawnY;
+    canBlastWalls = explosives > 0;
+    
+    FastRandom rng(levelSeed);
+    
+    layoutData = descriptor.layout;
+    roomsWide = descriptor.roomsWide;
+    roomsHigh = descriptor.roomsHigh;
+    deltaCount = 0;
+    deltaOverflows = 0;
+    pageCount = 0;
+    
+    if (descriptor.flags & LevelFlags::PROCEDURAL) {
+        windowRoomX = 0;
+        windowRoomY = 0;
+        generateLayout(rng);  // sets totalGoldCount
+        updateTreasureProximity(0, MapConstants::WORLD_SIZE - 1);
+    } else {
+        // Start with the spawn room resident, as far top-left as it fits
+        uint8_t roomX = spawnX / MapConstants::ROOM_SIZE;
+        uint8_t roomY = spawnY / MapConstants::ROOM_SIZE;
+        pageWindow(min(roomX, static_cast<uint8_t>(roomsWide - MapConstants::ROOMS_PER_ROW)),
+                   min(roomY, static_cast<uint8_t>(roomsHigh - MapConstants::ROOMS_PER_ROW)));
+        totalGoldCount = descriptor.goldCount;  // counted by tools/levelc
+    }
+    
+    uint8_t minBombs = descriptor.minBombs;
+    uint8_t maxBombs = descriptor.maxBombs;
+    if (settings) {
+        minBombs = settings->getMinBombsForLevel(currentLevel);
+        maxBombs = settings->getMaxBombsForLevel(currentLevel);
+    }
+    
+    // Placement and its solvability check only see the resident window, so
+    // paged worlds keep the bombs (if any) drawn into their layout
+    lastPlacementAttempts = 0;
+    if (maxBombs > 0 && !isPaged()) {
+        // Redo placements that cut off the exit or some gold; after the last
+        // retry, place bombs one at a time and drop any that would.
+        bool solvable = false;
+        while (!solvable && lastPlacementAttempts < SystemDefaultConstants::MAX_BOMB_PLACEMENT_RETRIES) {
+            lastPlacementAttempts++;
+            placeRandomBombs(minBombs, maxBombs, rng, false);
+            solvable = isSolvable();
+            if (!solvable) {
+                clearBombs();
+            }
+        }
+        if (!solvable) {
+            lastPlacementAttempts++;
+            placeRandomBombs(minBombs, maxBombs, rng, true);
+        }
+    }
+    
+    lastLoadMicros = micros() - loadStart;
 }
 
-void Map::createLevel1(uint8_t minBombs, uint8_t maxBombs)
+
+void Map::placeRandomBombs(uint8_t minBombs, uint8_t maxBombs, FastRandom& rng, bool keepSolvable)
 {
-    loadLayoutFromArray(LEVEL_1_LAYOUT);
-    placeRandomBombs(minBombs, maxBombs);
+    // Every empty interior tile that may hold a bomb, packed as y << 4 | x
+    uint8_t candidates[MapConstants::MAX_BOMB_CANDIDATES];
+    uint8_t candidateCount = 0;
+    
+    for (uint8_t y = 1; y < MapConstants::WORLD_SIZE - 1; y++)
+    {
+        if (y == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || y == MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
+            continue;
+        }
+        
+        for (uint8_t x = 1; x < MapConstants::WORLD_SIZE - 1; x++)
+        {
+            if (x == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || x == MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
+                continue;
+            }
+            if (x == spawnX && y == spawnY) {
+                continue;
+            }
+            if (readTile(x, y) == TileType::EMPTY) {
+                candidates[candidateCount++] = (y << 4) | x;
+            }
+        }
+    }
+    
+    uint8_t bombCount = minBombs + rng.below(maxBombs - minBombs + 1);
+    if (bombCount > candidateCount) {
+        bombCount = candidateCount;
+    }
+    
+    // Partial Fisher-Yates: each step draws a uniform pick from the unused
+    // candidates. With keepSolvable, picks that break the level are undone
+    // and the shuffle simply continues.
+    uint8_t placed = 0;
+    for (uint8_t i = 0; i < candidateCount && placed < bombCount; i++)
+    {
+        uint8_t j = i + rng.below(candidateCount - i);
+        uint8_t picked = candidates[j];
+        candidates[j] = candidates[i];
+        candidates[i] = picked;
+        
+        uint8_t x = picked & 0x0F;
+        uint8_t y = picked >> 4;
+        setTile(x, y, TileType::BOMB);
+        
+        if (keepSolvable && !isSolvable()) {
+            setTile(x, y, TileType::EMPTY);
+            continue;
+        }
+        placed++;
+    }
 }
 
-void Map::createLevel2(uint8_t minBombs, uint8_t maxBombs)
+void Map::clearBombs()
 {
-    loadLayoutFromArray(LEVEL_2_LAYOUT);
-    placeRandomBombs(minBombs, maxBombs);
+    for (uint8_t y = 0; y < MapConstants::WORLD_SIZE; y++) {
+        uint16_t bombs = getPlaneRow(TilePlane::BOMB, y);
+        for (uint8_t x = 0; bombs != 0; x++, bombs <<= 1) {
+            if (bombs & 0x8000u) {
+                setTile(x, y, TileType::EMPTY);
+            }
+        }
+    }
 }
 
-void Map::createLevel3(uint8_t minBombs, uint8_t maxBombs)
+// Flood fill from the spawn over 16-bit row masks (bit 15 = column 0).
+// Bombs are never crossed; with allowBlasting, walls and hidden gold are,
+// where explosives can clear them (interior tiles off the border and room
+// separators).
+void Map::floodFill(uint16_t reached[MapConstants::WORLD_SIZE], bool allowBlasting) const
 {
-    loadLayoutFromArray(LEVEL_3_LAYOUT);
-    placeRandomBombs(minBombs, maxBombs);
+    const uint16_t BLASTABLE_COLUMNS = 0x7E7E;  // columns 1-6 and 9-14
+    
+    uint16_t passable[MapConstants::WORLD_SIZE];
+    for (uint8_t y = 0; y < MapConstants::WORLD_SIZE; y++) {
+        uint16_t solid = getPlaneRow(TilePlane::WALL, y) | getPlaneRow(TilePlane::HIDDEN_GOLD, y);
+        if (allowBlasting && y != MapBoundaryConstants::MAP_BOUNDARY_MIN && y != MapBoundaryConstants::MAP_BOUNDARY_MAX
+            && y != MapBoundaryConstants::ROOM_SEPARATOR_LOWER && y != MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
+            solid &= ~BLASTABLE_COLUMNS;
+        }
+        passable[y] = ~(solid | getPlaneRow(TilePlane::BOMB, y));
+        reached[y] = 0;
+    }
+    
+    reached[spawnY] = 0x8000u >> spawnX;
+    
+    // Sweep down and up until nothing changes; each row spreads sideways
+    // through its passable run and seeds its neighbours.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint8_t pass = 0; pass < 2; pass++) {
+            for (uint8_t i = 0; i < MapConstants::WORLD_SIZE; i++) {
+                uint8_t y = pass == 0 ? i : MapConstants::WORLD_SIZE - 1 - i;
+                
+                uint16_t row = reached[y];
+                if (y > 0) row |= reached[y - 1];
+                if (y < MapConstants::WORLD_SIZE - 1) row |= reached[y + 1];
+                row &= passable[y];
+                
+                uint16_t spread;
+                do {
+                    spread = row;
+                    row = (row | (row << 1) | (row >> 1)) & passable[y];
+                } while (row != spread);
+                
+                if (row != reached[y]) {
+                    reached[y] = row;
+                    changed = true;
+                }
+            }
+        }
+    }
 }
 
-void Map::placeRandomBombs(uint8_t minBombs, uint8_t maxBombs)
+// Solvable: the exit and every gold tile can be reached without a bomb hit
+// (blasting allowed on levels that grant explosives).
+bool Map::isSolvable() const
 {
-    randomSeed(millis());
+    uint16_t reached[MapConstants::WORLD_SIZE];
+    floodFill(reached, canBlastWalls);
     
-    uint8_t bombCount = random(minBombs, maxBombs + 1);
-    uint8_t bombsPlaced = 0;
+    if (!(reached[exitY] & (0x8000u >> exitX))) {
+        return false;
+    }
+    for (uint8_t y = 0; y < MapConstants::WORLD_SIZE; y++) {
+        uint16_t gold = getPlaneRow(TilePlane::GOLD, y);
+        if ((gold & reached[y]) != gold) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Builds a 2x2-room world from the level seed: border and separator walls,
+// a few short wall segments per room, double-width doors on three of the
+// four separators (always a spanning tree, so every room is connected), an
+// exit on the right border of the bottom-right room, gold on tiles reachable
+// without explosives and hidden gold in blastable walls next to them.
+// Memory is fixed: a 144-byte candidate list and two 32-byte row masks on
+// the stack.
+void Map::generateLayout(FastRandom& rng)
+{
+    const uint8_t SIZE = MapConstants::WORLD_SIZE;
+    const uint8_t ROOM = MapConstants::ROOM_SIZE;
+    uint16_t reached[MapConstants::WORLD_SIZE];
     
-    uint8_t attempts = 0;
-    while (bombsPlaced < bombCount && attempts < SystemDefaultConstants::MAX_ATTEMPTS_BOMB_PLACEMENT)
+    for (uint8_t attempt = 0; ; attempt++)
     {
-        attempts++;
+        clearMap();
         
-        uint8_t x = random(1, MapConstants::WORLD_SIZE - 1);
-        uint8_t y = random(1, MapConstants::WORLD_SIZE - 1);
+        // Border and separator lines (placing a wall twice is harmless)
+        for (uint8_t i = 0; i < SIZE; i++) {
+            placeTile(i, MapBoundaryConstants::MAP_BOUNDARY_MIN, TileType::WALL);
+            placeTile(i, MapBoundaryConstants::MAP_BOUNDARY_MAX, TileType::WALL);
+            placeTile(i, MapBoundaryConstants::ROOM_SEPARATOR_LOWER, TileType::WALL);
+            placeTile(i, MapBoundaryConstants::ROOM_SEPARATOR_UPPER, TileType::WALL);
+            placeTile(MapBoundaryConstants::MAP_BOUNDARY_MIN, i, TileType::WALL);
+            placeTile(MapBoundaryConstants::MAP_BOUNDARY_MAX, i, TileType::WALL);
+            placeTile(MapBoundaryConstants::ROOM_SEPARATOR_LOWER, i, TileType::WALL);
+            placeTile(MapBoundaryConstants::ROOM_SEPARATOR_UPPER, i, TileType::WALL);
+        }
         
-        if (x == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || x == MapBoundaryConstants::ROOM_SEPARATOR_UPPER || y == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || y == MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
-            continue;
+        // The last attempt keeps rooms open, which is always solvable
+        if (attempt < ProceduralConstants::MAX_GENERATION_RETRIES) {
+            for (uint8_t room = 0; room < MapConstants::ROOM_COUNT; room++) {
+                uint8_t originX = (room % MapConstants::ROOMS_PER_ROW) * ROOM;
+                uint8_t originY = (room / MapConstants::ROOMS_PER_ROW) * ROOM;
+                
+                for (uint8_t segment = 0; segment < ProceduralConstants::WALL_SEGMENTS_PER_ROOM; segment++) {
+                    bool vertical = rng.next() & 1;
+                    uint8_t length = ProceduralConstants::MIN_SEGMENT_LENGTH
+                                   + rng.below(ProceduralConstants::MAX_SEGMENT_LENGTH - ProceduralConstants::MIN_SEGMENT_LENGTH + 1);
+                    uint8_t x = originX + 1 + rng.below(ROOM - 2);
+                    uint8_t y = originY + 1 + rng.below(ROOM - 2);
+                    
+                    for (uint8_t i = 0; i < length; i++) {
+                        uint8_t wx = vertical ? x : x + i;
+                        uint8_t wy = vertical ? y + i : y;
+                        if (wx >= originX + ROOM - 1 || wy >= originY + ROOM - 1) {
+                            break;
+                        }
+                        // Leave the spawn and the tiles around it open
+                        if (wx <= spawnX + 1 && wy <= spawnY + 1 && wx + 1 >= spawnX && wy + 1 >= spawnY) {
+                            continue;
+                        }
+                        setTile(wx, wy, TileType::WALL);
+                    }
+                }
+            }
         }
         
-        if (x == SpawnConstants::DEFAULT_SPAWN_X && y == SpawnConstants::DEFAULT_SPAWN_Y) {
-            continue;
+        // Doors: 0 = top rooms, 1 = bottom rooms, 2 = left rooms, 3 = right rooms.
+        // Skipping one of the four still connects all rooms.
+        uint8_t skipped = rng.below(4);
+        for (uint8_t link = 0; link < 4; link++) {
+            if (link == skipped) {
+                continue;
+            }
+            uint8_t offset = 1 + rng.below(ROOM - 3);  // door spans offset, offset + 1
+            for (uint8_t i = 0; i < 2; i++) {
+                if (link < 2) {
+                    uint8_t y = link * ROOM + offset + i;
+                    setTile(MapBoundaryConstants::ROOM_SEPARATOR_LOWER, y, TileType::DOOR);
+                    setTile(MapBoundaryConstants::ROOM_SEPARATOR_UPPER, y, TileType::DOOR);
+                    setTile(MapBoundaryConstants::ROOM_SEPARATOR_LOWER - 1, y, TileType::EMPTY);
+                    setTile(MapBoundaryConstants::ROOM_SEPARATOR_UPPER + 1, y, TileType::EMPTY);
+                } else {
+                    uint8_t x = (link - 2) * ROOM + offset + i;
+                    setTile(x, MapBoundaryConstants::ROOM_SEPARATOR_LOWER, TileType::DOOR);
+                    setTile(x, MapBoundaryConstants::ROOM_SEPARATOR_UPPER, TileType::DOOR);
+                    setTile(x, MapBoundaryConstants::ROOM_SEPARATOR_LOWER - 1, TileType::EMPTY);
+                    setTile(x, MapBoundaryConstants::ROOM_SEPARATOR_UPPER + 1, TileType::EMPTY);
+                }
+            }
         }
         
-        TileType tile = getTile(x, y);
-        if (tile == TileType::EMPTY)
-        {
-            setTile(x, y, TileType::BOMB);
-            bombsPlaced++;
+        exitX = MapBoundaryConstants::MAP_BOUNDARY_MAX;
+        exitY = ROOM + 1 + rng.below(ROOM - 2);
+        setTile(exitX, exitY, TileType::EXIT);
+        setTile(exitX - 1, exitY, TileType::EMPTY);
+        
+        floodFill(reached, false);
+        if (reached[exitY] & (0x8000u >> exitX)) {
+            break;
+        }
+    }
+    
+    // Gold: a partial shuffle over the empty tiles reachable on foot
+    uint8_t candidates[MapConstants::MAX_BOMB_CANDIDATES];
+    uint8_t candidateCount = 0;
+    for (uint8_t y = 1; y < SIZE - 1; y++) {
+        for (uint8_t x = 1; x < SIZE - 1; x++) {
+            if ((reached[y] & (0x8000u >> x)) && readTile(x, y) == TileType::EMPTY
+                && !(x == spawnX && y == spawnY) && candidateCount < MapConstants::MAX_BOMB_CANDIDATES) {
+                candidates[candidateCount++] = (y << 4) | x;
+            }
+        }
+    }
+    
+    totalGoldCount = 0;
+    for (uint8_t i = 0; i < candidateCount && totalGoldCount < ProceduralConstants::GOLD_COUNT; i++) {
+        uint8_t j = i + rng.below(candidateCount - i);
+        uint8_t picked = candidates[j];
+        candidates[j] = candidates[i];
+        setTile(picked & 0x0F, picked >> 4, TileType::GOLD);
+        totalGoldCount++;
+    }
+    
+    // Hidden gold: interior walls (blastable) touching a reachable tile
+    candidateCount = 0;
+    for (uint8_t y = 1; y < SIZE - 1; y++) {
+        if (y == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || y == MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
+            continue;
+        }
+        uint16_t nearReached = reached[y - 1] | reached[y + 1] | (reached[y] << 1) | (reached[y] >> 1);
+        for (uint8_t x = 1; x < SIZE - 1; x++) {
+            if (x == MapBoundaryConstants::ROOM_SEPARATOR_LOWER || x == MapBoundaryConstants::ROOM_SEPARATOR_UPPER) {
+                continue;
+            }
+            if ((nearReached & (0x8000u >> x)) && readTile(x, y) == TileType::WALL) {
+                candidates[candidateCount++] = (y << 4) | x;
+            }
         }
     }
+    
+    uint8_t hiddenPlaced = 0;
+    for (uint8_t i = 0; i < candidateCount && hiddenPlaced < ProceduralConstants::HIDDEN_GOLD_COUNT; i++) {
+        uint8_t j = i + rng.below(candidateCount - i);
+        uint8_t picked = candidates[j];
+        candidates[j] = candidates[i];
+        setTile(picked & 0x0F, picked >> 4, TileType::HIDDEN_GOLD);
+        hiddenPlaced++;
+    }
+}
+
+void Map::printDebug() const
+{
+    Serial.print(F("Map - Seed: "));
+    Serial.print(levelSeed);
+    Serial.print(F(" | Load: "));
+    Serial.print(lastLoadMicros);
+    Serial.print(F("us | Bomb placements: "));
+    Serial.print(lastPlacementAttempts);
+    Serial.print(F(" | Page: "));
+    Serial.print(lastPageMicros);
+    Serial.print(F("us | Pages: "));
+    Serial.print(pageCount);
+    Serial.print(F(" | Deltas: "));
+    Serial.print(deltaCount);
+    Serial.print(F(" (dropped "));
+    Serial.print(deltaOverflows);
+    Serial.println(F(")"));
 }
@@ -4,43 +4,164 @@
 #include <Arduino.h>
 #include "Constants.h"
 
+class FastRandom;
+class GameSettings;
+
+// Tile storage: 1 = two 4-bit tiles per byte (128 bytes), 0 = one byte per tile (256 bytes)
+#ifndef MAP_PACKED_TILES
+#define MAP_PACKED_TILES 1
+#endif
+
+// Tile types that get their own bitplane
+enum class TilePlane : uint8_t
+{
+    WALL,
+    GOLD,
+    BOMB,
+    HIDDEN_GOLD,
+    COUNT,
+    NONE = COUNT
+};
+
+// Worlds are grids of 8x8 rooms. A 2x2-room window of them is resident in
+// RAM (the 16x16 arrays below); levels larger than 2x2 rooms page rooms in
+// from flash as the player crosses into them. All public coordinates are
+// world coordinates; the private helpers work on window coordinates.
 class Map
 {
 private:
-    // Map data storage (16x16 = 256 bytes)
+    // Tile change in a paged world, replayed when its room is paged back in
+    struct TileDelta
+    {
+        uint8_t room;   // world room index
+        uint8_t pos;    // y << 3 | x inside the room
+        TileType type;
+    };
+    
+    // Map data storage (16x16 tiles; 128 bytes packed, 256 bytes unpacked)
+#if MAP_PACKED_TILES
+    uint8_t mapData[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE / 2];
+#else
     uint8_t mapData[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE];
+#endif
+    
+    // One 16x16 bitplane (32 bytes) per TilePlane, kept in sync by setTile.
+    // Stored room by room, one byte per row (MSB = column 0), so a room row
+    // is a single byte and can go straight into the matrix frame buffer.
+    uint8_t tilePlanes[static_cast<uint8_t>(TilePlane::COUNT)][MapConstants::ROOM_COUNT][MapConstants::ROOM_SIZE];
+    
+    // Tiles within TREASURE_DETECTION_RADIUS of hidden gold (bit 15 = column 0)
+    uint16_t treasureProximity[MapConstants::WORLD_SIZE];
+    
+    // World layout and resident window
+    const uint8_t* layoutData;  // PROGMEM, LevelFormat encoded; nullptr for generated levels
+    uint8_t roomsWide;
+    uint8_t roomsHigh;
+    uint8_t windowRoomX;        // world room at the window's top-left corner
+    uint8_t windowRoomY;
+    
+    TileDelta deltaLog[MapConstants::DELTA_LOG_SIZE];
+    uint8_t deltaCount;
+    uint8_t deltaOverflows;     // changes dropped because the log was full (levelc rules it out)
     
     // Level state
     uint8_t currentLevel;   
-    uint8_t totalGoldCount; 
+    uint8_t totalGoldCount;  // gold in the layout plus any uncovered by explosions
+    uint8_t spawnX;
+    uint8_t spawnY;
+    uint16_t levelSeed;     // seeds bomb placement and procedural layouts
+    uint8_t exitX;
+    uint8_t exitY;
+    bool canBlastWalls;     // player has explosives: interior walls count as passable
+    
+    // Level load profiling
+    unsigned long lastLoadMicros;
+    uint8_t lastPlacementAttempts;
+    unsigned long lastPageMicros;
+    uint16_t pageCount;
     
     void clearMap();
-    void loadLayoutFromArray(const uint8_t layout[MapConstants::WORLD_SIZE][MapConstants::WORLD_SIZE]); 
-    void createLevel0();  
-    void createLevel1(uint8_t minBombs, uint8_t maxBombs);  
-    void createLevel2(uint8_t minBombs, uint8_t maxBombs);
-    void createLevel3(uint8_t minBombs, uint8_t maxBombs);
-    void placeRandomBombs(uint8_t minBombs, uint8_t maxBombs);  
+    TileType readTile(uint8_t x, uint8_t y) const;
+    void writeTile(uint8_t x, uint8_t y, TileType type);
+    bool toLocal(uint8_t x, uint8_t y, uint8_t& localX, uint8_t& localY) const;
+    void setLocalTile(uint8_t x, uint8_t y, TileType type);
+    void pageWindow(uint8_t roomX, uint8_t roomY);
+    void clearRoomSlot(uint8_t slot);
+    void decodeRoom(uint8_t worldRoom, uint8_t slot);
+    void recordDelta(uint8_t x, uint8_t y, TileType type);
+    TileType readPagedOutTile(uint8_t x, uint8_t y) const;
+    void placeTile(uint8_t x, uint8_t y, TileType type);
+    void placeRandomBombs(uint8_t minBombs, uint8_t maxBombs, FastRandom& rng, bool keepSolvable);
+    void clearBombs();
+    void floodFill(uint16_t reached[MapConstants::WORLD_SIZE], bool allowBlasting) const;
+    bool isSolvable() const;
+    void generateLayout(FastRandom& rng);
+    void updatePlaneBit(TilePlane plane, uint8_t x, uint8_t y, bool set);
+    bool testPlaneBit(TilePlane plane, uint8_t x, uint8_t y) const;
+    static TilePlane planeForTile(TileType tile);
+    void updateTreasureProximity(uint8_t minY, uint8_t maxY);
 
 public:
     Map();
     
-    void loadLevel(uint8_t level, class GameSettings* settings = nullptr); 
+    // explosives: what the player will carry into the level; walls only
+    // count as passable for the bomb solvability check when it is above 0
+    void loadLevel(uint8_t level, GameSettings* settings = nullptr, uint8_t explosives = 0);
     
-    // Tile queries (read-only)
+    // Tile queries (read-only). getTile also sees paged-out rooms (delta log,
+    // then flash); the others treat tiles outside the window as walls.
     TileType getTile(uint8_t x, uint8_t y) const;
     bool isSolid(uint8_t x, uint8_t y) const;
     bool isWalkable(uint8_t x, uint8_t y) const;
     
-    // Tile modification
+    // Tile modification. In paged worlds a tile outside the window goes
+    // straight to the delta log, e.g. a blast across a room the player left.
     void setTile(uint8_t x, uint8_t y, TileType type);
     void collectGold(uint8_t x, uint8_t y);
     
     uint8_t getTotalGold() const { return totalGoldCount; }
     uint8_t getCurrentLevel() const { return currentLevel; }
+    uint8_t getSpawnX() const { return spawnX; }
+    uint8_t getSpawnY() const { return spawnY; }
+    
+    // World size in tiles (16x16 unless the level is paged)
+    uint8_t getWorldWidth() const { return roomsWide * MapConstants::ROOM_SIZE; }
+    uint8_t getWorldHeight() const { return roomsHigh * MapConstants::ROOM_SIZE; }
+    bool isPaged() const { return roomsWide > MapConstants::ROOMS_PER_ROW || roomsHigh > MapConstants::ROOMS_PER_ROW; }
+    
+    // Makes the room containing (x, y) resident, shifting the window by one
+    // room if needed
+    void pageIn(uint8_t x, uint8_t y);
+    
+    // Same seed + same level + same difficulty = same map
+    void setLevelSeed(uint16_t seed) { levelSeed = seed; }
+    uint16_t getLevelSeed() const { return levelSeed; }
+    
+    void printDebug() const;
     
     // Bounds checking
     bool isInBounds(uint8_t x, uint8_t y) const;
+    
+    // Bitplane rows of the room whose top-left corner is (roomOriginX, roomOriginY)
+    const uint8_t* getRoomPlane(TilePlane plane, uint8_t roomOriginX, uint8_t roomOriginY) const;
+    // Full 16-tile row of the resident window's bitplane, bit 15 = column 0
+    uint16_t getPlaneRow(TilePlane plane, uint8_t y) const;
+    // Hidden gold within TREASURE_DETECTION_RADIUS of (x, y)? Single bit test.
+    bool isNearHiddenGold(uint8_t x, uint8_t y) const;
+    
+    // Window slot (0-3) of window coordinates
+    static uint8_t getRoomIndex(uint8_t x, uint8_t y)
+    {
+        return (y / MapConstants::ROOM_SIZE) * MapConstants::ROOMS_PER_ROW + (x / MapConstants::ROOM_SIZE);
+    }
+    
+    // Outer ring of a room: map border and separators, which explosions can't clear
+    static bool isRoomEdge(uint8_t x, uint8_t y)
+    {
+        uint8_t roomX = x % MapConstants::ROOM_SIZE;
+        uint8_t roomY = y % MapConstants::ROOM_SIZE;
+        return roomX == 0 || roomX == MapConstants::ROOM_SIZE - 1 || roomY == 0 || roomY == MapConstants::ROOM_SIZE - 1;
+    }
 };
 
 #endif // MAP_H
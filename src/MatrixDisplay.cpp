@@ -1,23 +1,42 @@
 #include "MatrixDisplay.h"
 
 MatrixDisplay::MatrixDisplay(uint8_t dinPin, uint8_t clkPin, uint8_t csPin)
-    : lc(dinPin, clkPin, csPin, MatrixConstants::DEVICE_COUNT)
+    : driver(dinPin, clkPin, csPin, MatrixConstants::DEVICE_COUNT)
     , brightness(DisplayConstants::DEFAULT_MATRIX_BRIGHTNESS) 
-    , frameCounter(0)
+    , frameTime(0)
+    , goldBlinkOn(false)
+    , bombBlinkOn(false)
     , photoResistor(nullptr)
+    , scrollDX(0)
+    , scrollDY(0)
+    , scrollOffset(0)
+    , scrolling(false)
+    , rowsWritten(0)
+    , rowsSkipped(0)
+    , lastDrawMicros(0)
+    , maxDrawMicros(0)
 {
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+    memset(shownBuffer, 0, sizeof(shownBuffer));
+    memset(scrollFrame, 0, sizeof(scrollFrame));
+    memset(scrollIncoming, 0, sizeof(scrollIncoming));
+    clearOverlays();
 }
 
 void MatrixDisplay::begin()
 {
-    lc.shutdown(0, false);
-    lc.setIntensity(0, brightness);
+    driver.begin();
+    driver.setShutdown(0, false);
+    driver.setIntensity(0, brightness);
     clear();
 }
 
 void MatrixDisplay::clear()
 {
-    lc.clearDisplay(0);
+    scrolling = false;
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+    memset(shownBuffer, 0, sizeof(shownBuffer));
+    driver.writeAllRows(frameBuffer);
 }
 
 void MatrixDisplay::setBrightness(uint8_t level)
@@ -29,7 +48,7 @@ void MatrixDisplay::setBrightness(uint8_t level)
     }
     
     brightness = level;
-    lc.setIntensity(0, brightness);
+    driver.setIntensity(0, brightness);
 }
 
 void MatrixDisplay::setPhotoResistor(PhotoResistor* pr)
@@ -37,95 +56,288 @@ void MatrixDisplay::setPhotoResistor(PhotoResistor* pr)
     photoResistor = pr;
 }
 
-void MatrixDisplay::draw(Map& map, Player& player, CameraController& camera)
+void MatrixDisplay::draw(Map& map, Player& player, CameraController& camera, unsigned long currentTime)
 {
-    frameCounter++;
+    unsigned long drawStart = micros();
     
-    clear();
+    // Blink phases follow wall-clock time, not how often draw() gets called
+    frameTime = currentTime;
+    goldBlinkOn = isBlinkOn(DisplayConstants::GOLD_BLINK_PERIOD_MS, DisplayConstants::GOLD_BLINK_ON_MS);
+    bombBlinkOn = isBlinkOn(DisplayConstants::BOMB_BLINK_PERIOD_MS, DisplayConstants::BOMB_BLINK_ON_MS);
+    
+    // Build the whole frame in RAM, layer by layer, then flush it once
+    if (scrolling)
+    {
+        // Transition frames only move tile bytes; blinking gold and bombs
+        // come back once the new room is fully on screen
+        scrollStep();
+    }
+    else
+    {
+        composeTiles(map, camera);
+    }
+    
+    composePixel(player.getX(), player.getY(), true, camera);
+    composeLayer(MatrixLayer::ENTITIES, camera);
+    composeLayer(MatrixLayer::EFFECTS, camera);
     
-    uint8_t playerX = player.getX();
-    uint8_t playerY = player.getY();
-    uint8_t localPlayerX = 0, localPlayerY = 0;
-    bool playerInView = false;
+    flush();
     
-    if (camera.isInViewport(playerX, playerY))
+    lastDrawMicros = micros() - drawStart;
+    if (lastDrawMicros > maxDrawMicros)
     {
-        if (camera.globalToLocal(playerX, playerY, localPlayerX, localPlayerY))
+        maxDrawMicros = lastDrawMicros;
+    }
+}
+
+void MatrixDisplay::composeTiles(Map& map, CameraController& camera)
+{
+    uint8_t cameraX = camera.getCameraX();
+    uint8_t cameraY = camera.getCameraY();
+    
+    const uint8_t* walls = map.getRoomPlane(TilePlane::WALL, cameraX, cameraY);
+    const uint8_t* gold = map.getRoomPlane(TilePlane::GOLD, cameraX, cameraY);
+    const uint8_t* bombs = map.getRoomPlane(TilePlane::BOMB, cameraX, cameraY);
+    
+    // Bombs visible ONLY when light is detected
+    bool bombsVisible = bombBlinkOn && photoResistor && photoResistor->isBright();
+    
+    // Empty, door, exit and hidden gold tiles stay dark
+    for (uint8_t localY = 0; localY < MapConstants::ROOM_SIZE; localY++)
+    {
+        uint8_t rowBits = walls[localY];
+        
+        if (goldBlinkOn)
         {
-            playerInView = true;
+            rowBits |= gold[localY];
         }
+        if (bombsVisible)
+        {
+            rowBits |= bombs[localY];
+        }
+        
+        frameBuffer[0][localY] = rowBits;
     }
+}
+
+void MatrixDisplay::startRoomScroll(Map& map, uint8_t cameraX, uint8_t cameraY, int8_t dx, int8_t dy)
+{
+    uint8_t outgoingX = cameraX - dx * MapConstants::ROOM_SIZE;
+    uint8_t outgoingY = cameraY - dy * MapConstants::ROOM_SIZE;
+    const uint8_t* outgoingWalls = map.getRoomPlane(TilePlane::WALL, outgoingX, outgoingY);
+    const uint8_t* outgoingGold = map.getRoomPlane(TilePlane::GOLD, outgoingX, outgoingY);
+    const uint8_t* walls = map.getRoomPlane(TilePlane::WALL, cameraX, cameraY);
+    const uint8_t* gold = map.getRoomPlane(TilePlane::GOLD, cameraX, cameraY);
     
-    for (uint8_t localY = 0; localY < MapConstants::ROOM_SIZE; localY++)
+    // Snapshots of both rooms (walls and steady gold); both are resident,
+    // so nothing is decoded while the scroll runs
+    for (uint8_t row = 0; row < MatrixConstants::SIZE; row++)
+    {
+        scrollFrame[row] = outgoingWalls[row] | outgoingGold[row];
+        scrollIncoming[row] = walls[row] | gold[row];
+    }
+    
+    scrollDX = dx;
+    scrollDY = dy;
+    scrollOffset = 0;
+    scrolling = true;
+}
+
+void MatrixDisplay::scrollStep()
+{
+    for (uint8_t step = 0; step < DisplayConstants::ROOM_SCROLL_STEP && scrollOffset < MatrixConstants::SIZE; step++)
     {
-        for (uint8_t localX = 0; localX < MapConstants::ROOM_SIZE; localX++)
+        uint8_t* frame = scrollFrame;
+        
+        if (scrollDX > 0)
         {
-            if (playerInView && localX == localPlayerX && localY == localPlayerY)
+            // Content moves left, column scrollOffset of the new room enters on the right
+            for (uint8_t row = 0; row < MatrixConstants::SIZE; row++)
             {
-                drawPlayer(localX, localY);
+                frame[row] = (frame[row] << 1) | ((scrollIncoming[row] << scrollOffset) >> 7 & 1);
             }
-            else
+        }
+        else if (scrollDX < 0)
+        {
+            // Content moves right, the new room enters on the left from its last column
+            for (uint8_t row = 0; row < MatrixConstants::SIZE; row++)
             {
-                uint8_t globalX = camera.getCameraX() + localX;
-                uint8_t globalY = camera.getCameraY() + localY;
-                
-                TileType tile = map.getTile(globalX, globalY);
-                
-                drawTile(localX, localY, tile);
+                frame[row] = (frame[row] >> 1) | ((scrollIncoming[row] >> scrollOffset << 7) & MatrixConstants::ROW_MSB);
             }
         }
+        else if (scrollDY > 0)
+        {
+            memmove(frame, frame + 1, MatrixConstants::SIZE - 1);
+            frame[MatrixConstants::SIZE - 1] = scrollIncoming[scrollOffset];
+        }
+        else
+        {
+            memmove(frame + 1, frame, MatrixConstants::SIZE - 1);
+            frame[0] = scrollIncoming[MatrixConstants::SIZE - 1 - scrollOffset];
+        }
+        
+        scrollOffset++;
+    }
+    
+    memcpy(frameBuffer[0], scrollFrame, MatrixConstants::SIZE);
+    
+    if (scrollOffset >= MatrixConstants::SIZE)
+    {
+        scrolling = false;
     }
 }
 
-void MatrixDisplay::drawTile(uint8_t localX, uint8_t localY, TileType tile)
+void MatrixDisplay::composeLayer(MatrixLayer layer, CameraController& camera)
 {
-    bool ledState = false;
-    
-    switch (tile)
+    for (uint8_t slot = 0; slot < MatrixConstants::OVERLAY_SLOTS; slot++)
     {
-        case TileType::EMPTY:
-            ledState = false;
-            break;
-        
-        case TileType::WALL:
-            ledState = true;
-            break;
-        
-        case TileType::HIDDEN_GOLD:              
-            ledState = false;              
-            break;
-        
-        case TileType::GOLD:
-            ledState = (frameCounter % DisplayConstants::GOLD_BLINK_CYCLE < DisplayConstants::GOLD_BLINK_ON_FRAMES);
-            break;
-        
-        case TileType::DOOR:
-            ledState = false;
-            break;
+        const MatrixOverlay& overlay = overlays[slot];
+        if (!overlay.active || overlay.layer != layer)
+        {
+            continue;
+        }
         
-        case TileType::EXIT:
-            ledState = false;
-            break;
+        bool state = true;
+        if (overlay.blinkPeriodMs > 0)
+        {
+            state = isBlinkOn(overlay.blinkPeriodMs, overlay.blinkOnMs);
+        }
         
-        case TileType::BOMB:
-            // Bombs visible ONLY when light is detected
-            if (photoResistor && photoResistor->isBright()) {
-                ledState = (frameCounter % DisplayConstants::BOMB_BLINK_CYCLE < DisplayConstants::BOMB_BLINK_ON_FRAMES);
-            } else {
-                ledState = false;  
-            }
-            break;
+        composePixel(overlay.x, overlay.y, state, camera);
+    }
+}
+
+void MatrixDisplay::composePixel(uint8_t globalX, uint8_t globalY, bool state, CameraController& camera)
+{
+    uint8_t localX = 0, localY = 0;
+    if (!toScreen(globalX, globalY, camera, localX, localY))
+    {
+        return;
     }
     
-    lc.setLed(0, localY, localX, ledState);
+    if (state)
+    {
+        frameBuffer[0][localY] |= columnMask(localX);
+    }
+    else
+    {
+        frameBuffer[0][localY] &= ~columnMask(localX);
+    }
 }
 
-void MatrixDisplay::drawPlayer(uint8_t localX, uint8_t localY)
+bool MatrixDisplay::toScreen(uint8_t globalX, uint8_t globalY, CameraController& camera,
+                             uint8_t& screenX, uint8_t& screenY) const
 {
-    lc.setLed(0, localY, localX, true);
+    if (!scrolling)
+    {
+        return camera.globalToLocal(globalX, globalY, screenX, screenY);
+    }
+    
+    // Mid-scroll the camera's room still sits (SIZE - scrollOffset) pixels
+    // past the edge it enters from, with the room being left beside it
+    int8_t pending = MatrixConstants::SIZE - scrollOffset;
+    int16_t x = static_cast<int16_t>(globalX) - camera.getCameraX() + scrollDX * pending;
+    int16_t y = static_cast<int16_t>(globalY) - camera.getCameraY() + scrollDY * pending;
+    if (x < 0 || x >= MatrixConstants::SIZE || y < 0 || y >= MatrixConstants::SIZE)
+    {
+        return false;
+    }
+    
+    screenX = x;
+    screenY = y;
+    return true;
+}
+
+void MatrixDisplay::flush()
+{
+    for (uint8_t row = 0; row < MatrixConstants::SIZE; row++)
+    {
+        flushRow(row);
+    }
+}
+
+void MatrixDisplay::flushRow(uint8_t row)
+{
+    // Walls are static and most frames repeat, so only changed rows go out
+    if (frameBuffer[0][row] == shownBuffer[0][row])
+    {
+        rowsSkipped++;
+        return;
+    }
+    
+    driver.writeRow(0, row, frameBuffer[0][row]);
+    shownBuffer[0][row] = frameBuffer[0][row];
+    rowsWritten++;
 }
 
 void MatrixDisplay::setLed(uint8_t x, uint8_t y, bool state)
 {
-    lc.setLed(0, y, x, state);
+    if (x >= MatrixConstants::SIZE || y >= MatrixConstants::SIZE)
+    {
+        return;
+    }
+    
+    if (state)
+    {
+        frameBuffer[0][y] |= columnMask(x);
+    }
+    else
+    {
+        frameBuffer[0][y] &= ~columnMask(x);
+    }
+    
+    flushRow(y);
+}
+
+void MatrixDisplay::setOverlay(uint8_t slot, MatrixLayer layer, uint8_t x, uint8_t y,
+                               uint16_t blinkPeriodMs, uint16_t blinkOnMs)
+{
+    if (slot >= MatrixConstants::OVERLAY_SLOTS)
+    {
+        return;
+    }
+    
+    MatrixOverlay& overlay = overlays[slot];
+    overlay.x = x;
+    overlay.y = y;
+    overlay.layer = layer;
+    overlay.blinkPeriodMs = blinkPeriodMs;
+    overlay.blinkOnMs = blinkOnMs;
+    overlay.active = true;
+}
+
+void MatrixDisplay::clearOverlay(uint8_t slot)
+{
+    if (slot < MatrixConstants::OVERLAY_SLOTS)
+    {
+        overlays[slot].active = false;
+    }
+}
+
+void MatrixDisplay::clearOverlays()
+{
+    for (uint8_t slot = 0; slot < MatrixConstants::OVERLAY_SLOTS; slot++)
+    {
+        overlays[slot].active = false;
+    }
+}
+
+void MatrixDisplay::resetStats()
+{
+    lastDrawMicros = 0;
+    maxDrawMicros = 0;
+    rowsWritten = 0;
+    rowsSkipped = 0;
+}
+
+void MatrixDisplay::printDebug() const
+{
+    Serial.print(F("MatrixDisplay - Draw: "));
+    Serial.print(lastDrawMicros);
+    Serial.print(F("us | Max: "));
+    Serial.print(maxDrawMicros);
+    Serial.print(F("us | Rows written: "));
+    Serial.print(rowsWritten);
+    Serial.print(F(" | Rows skipped: "));
+    Serial.println(rowsSkipped);
 }
@@ -2,37 +2,110 @@
 #define MATRIX_DISPLAY_H
 
 #include <Arduino.h>
-#include <LedControl.h>
+#include "Max7219.h"
 #include "Map.h"
 #include "Player.h"
 #include "CameraController.h"
 #include "Constants.h"
 #include "PhotoResistor.h"
 
+// Compositing order: tiles first, then entities (player), then effects.
+// Each overlay replaces whatever the layers below put on its pixel.
+enum class MatrixLayer : uint8_t
+{
+    BASE,
+    ENTITIES,
+    EFFECTS
+};
+
+struct MatrixOverlay
+{
+    uint8_t x;               // global (map) coordinates
+    uint8_t y;
+    MatrixLayer layer;
+    uint16_t blinkPeriodMs;  // 0 = steady
+    uint16_t blinkOnMs;
+    bool active;
+};
+
 class MatrixDisplay
 {
 private:
-    LedControl lc;
+    Max7219 driver;
     uint8_t brightness;
-    uint8_t frameCounter;
+    unsigned long frameTime;  // millis() of the frame being composed
+    bool goldBlinkOn;         // blink phases, evaluated once per frame
+    bool bombBlinkOn;
     PhotoResistor* photoResistor;
+    MatrixOverlay overlays[MatrixConstants::OVERLAY_SLOTS];
+    
+    // One byte per row, MSB = column 0 (MAX7219 digit register layout)
+    uint8_t frameBuffer[MatrixConstants::DEVICE_COUNT][MatrixConstants::SIZE];
+    
+    // Last frame actually sent to the MAX7219, used to skip unchanged rows
+    uint8_t shownBuffer[MatrixConstants::DEVICE_COUNT][MatrixConstants::SIZE];
+    
+    // Room transition: the tiles of the room being left are shifted by
+    // ROOM_SCROLL_STEP per frame while the new room's rows are fed in from
+    // the opposite edge. Entities and effects are drawn over the result.
+    uint8_t scrollFrame[MatrixConstants::SIZE];
+    uint8_t scrollIncoming[MatrixConstants::SIZE];
+    int8_t scrollDX;
+    int8_t scrollDY;
+    uint8_t scrollOffset;      // columns/rows of the new room already shown
+    bool scrolling;
+    
+    // SPI savings counters (rows sent vs rows left untouched)
+    unsigned long rowsWritten;
+    unsigned long rowsSkipped;
+    
+    // Time spent in draw() (compose + flush), for profiling
+    unsigned long lastDrawMicros;
+    unsigned long maxDrawMicros;
 
 public:
     MatrixDisplay(uint8_t dinPin, uint8_t clkPin, uint8_t csPin);
     
     void begin();
-    void draw(Map& map, Player& player, CameraController& camera);
+    void draw(Map& map, Player& player, CameraController& camera, unsigned long currentTime);
     void setBrightness(uint8_t level);
     uint8_t getBrightness() const { return brightness; }
     void clear();
     void setPhotoResistor(PhotoResistor* pr);
     
-    uint8_t getFrameCounter() const { return frameCounter; }
     void setLed(uint8_t x, uint8_t y, bool state);
+    
+    // Slide from the room on screen to the neighbouring room at (dx, dy)
+    // whose top-left corner is (cameraX, cameraY). Runs over the next few
+    // draw() calls; a new scroll or clear() replaces one in progress.
+    void startRoomScroll(Map& map, uint8_t cameraX, uint8_t cameraY, int8_t dx, int8_t dy);
+    void cancelRoomScroll() { scrolling = false; }
+    bool isScrolling() const { return scrolling; }
+    
+    // Overlays are merged into the frame by draw(), before the single flush
+    void setOverlay(uint8_t slot, MatrixLayer layer, uint8_t x, uint8_t y,
+                    uint16_t blinkPeriodMs = 0, uint16_t blinkOnMs = 0);
+    void clearOverlay(uint8_t slot);
+    void clearOverlays();
+    
+    unsigned long getLastDrawMicros() const { return lastDrawMicros; }
+    unsigned long getMaxDrawMicros() const { return maxDrawMicros; }
+    unsigned long getRowsWritten() const { return rowsWritten; }
+    unsigned long getRowsSkipped() const { return rowsSkipped; }
+    void resetStats();
+    void printDebug() const;
 
 private:
-    void drawTile(uint8_t localX, uint8_t localY, TileType tile);
-    void drawPlayer(uint8_t localX, uint8_t localY);
+    bool isBlinkOn(uint16_t periodMs, uint16_t onMs) const { return (frameTime % periodMs) < onMs; }
+    void composeTiles(Map& map, CameraController& camera);
+    void scrollStep();
+    void composeLayer(MatrixLayer layer, CameraController& camera);
+    void composePixel(uint8_t globalX, uint8_t globalY, bool state, CameraController& camera);
+    bool toScreen(uint8_t globalX, uint8_t globalY, CameraController& camera, uint8_t& screenX, uint8_t& screenY) const;
+    void flush();
+    void flushRow(uint8_t row);
+    
+    static uint8_t columnMask(uint8_t localX) { return MatrixConstants::ROW_MSB >> localX; }
 };
 
 #endif // MATRIX_DISPLAY_H
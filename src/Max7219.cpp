@@ -0,0 +1,192 @@
+#include "Max7219.h"
+
+Max7219::Max7219(uint8_t din, uint8_t clk, uint8_t load, uint8_t devices)
+    : dinPin(din)
+    , clkPin(clk)
+    , loadPin(load)
+    , deviceCount(devices > MAX_DEVICES ? MAX_DEVICES : devices)
+#ifdef MAX7219_MOCK
+    , mockLogLength(0)
+    , mockLatchCount(0)
+#else
+    , dinPort(nullptr)
+    , clkPort(nullptr)
+    , loadPort(nullptr)
+    , dinMask(0)
+    , clkMask(0)
+    , loadMask(0)
+    , savedSREG(0)
+#endif
+{
+}
+
+void Max7219::begin()
+{
+#ifndef MAX7219_MOCK
+    pinMode(dinPin, OUTPUT);
+    pinMode(clkPin, OUTPUT);
+    pinMode(loadPin, OUTPUT);
+    
+    dinPort = portOutputRegister(digitalPinToPort(dinPin));
+    clkPort = portOutputRegister(digitalPinToPort(clkPin));
+    loadPort = portOutputRegister(digitalPinToPort(loadPin));
+    dinMask = digitalPinToBitMask(dinPin);
+    clkMask = digitalPinToBitMask(clkPin);
+    loadMask = digitalPinToBitMask(loadPin);
+    
+    *clkPort &= ~clkMask;
+    *loadPort |= loadMask;
+#endif
+
+    // Same power-up sequence as LedControl: raw rows, all 8 digits scanned
+    writeRegisterAll(Max7219Registers::DISPLAY_TEST, 0);
+    writeRegisterAll(Max7219Registers::SCAN_LIMIT, ROWS - 1);
+    writeRegisterAll(Max7219Registers::DECODE_MODE, 0);
+    for (uint8_t device = 0; device < deviceCount; device++)
+    {
+        clear(device);
+    }
+    writeRegisterAll(Max7219Registers::SHUTDOWN, 0);
+}
+
+void Max7219::writeRegister(uint8_t device, uint8_t reg, uint8_t value)
+{
+    if (device >= deviceCount)
+    {
+        return;
+    }
+    
+    beginFrame();
+    // The last device in the chain is shifted first
+    for (uint8_t i = deviceCount; i > 0; i--)
+    {
+        if (i - 1 == device)
+        {
+            shiftByte(reg);
+            shiftByte(value);
+        }
+        else
+        {
+            shiftByte(Max7219Registers::NOOP);
+            shiftByte(0);
+        }
+    }
+    endFrame();
+}
+
+void Max7219::writeRegisterAll(uint8_t reg, uint8_t value)
+{
+    beginFrame();
+    for (uint8_t i = 0; i < deviceCount; i++)
+    {
+        shiftByte(reg);
+        shiftByte(value);
+    }
+    endFrame();
+}
+
+void Max7219::setShutdown(uint8_t device, bool shutdown)
+{
+    // SHUTDOWN register: 0 = shutdown mode, 1 = normal operation
+    writeRegister(device, Max7219Registers::SHUTDOWN, shutdown ? 0 : 1);
+}
+
+void Max7219::setIntensity(uint8_t device, uint8_t level)
+{
+    writeRegister(device, Max7219Registers::INTENSITY, level & 0x0F);
+}
+
+void Max7219::writeRow(uint8_t device, uint8_t row, uint8_t value)
+{
+    if (row >= ROWS)
+    {
+        return;
+    }
+    
+    writeRegister(device, Max7219Registers::DIGIT_0 + row, value);
+}
+
+void Max7219::clear(uint8_t device)
+{
+    for (uint8_t row = 0; row < ROWS; row++)
+    {
+        writeRow(device, row, 0);
+    }
+}
+
+void Max7219::writeAllRows(const uint8_t rows[][ROWS])
+{
+    for (uint8_t row = 0; row < ROWS; row++)
+    {
+        beginFrame();
+        for (uint8_t i = deviceCount; i > 0; i--)
+        {
+            shiftByte(Max7219Registers::DIGIT_0 + row);
+            shiftByte(rows[i - 1][row]);
+        }
+        endFrame();
+    }
+}
+
+#ifdef MAX7219_MOCK
+
+void Max7219::clearMockLog()
+{
+    mockLogLength = 0;
+    mockLatchCount = 0;
+}
+
+void Max7219::beginFrame()
+{
+}
+
+void Max7219::shiftByte(uint8_t value)
+{
+    if (mockLogLength < MOCK_LOG_SIZE)
+    {
+        mockLog[mockLogLength++] = value;
+    }
+}
+
+void Max7219::endFrame()
+{
+    mockLatchCount++;
+}
+
+#else
+
+void Max7219::beginFrame()
+{
+    // PORTB is shared with other pins; keep ISRs from interleaving a
+    // read-modify-write while a frame is being shifted
+    savedSREG = SREG;
+    cli();
+    *loadPort &= ~loadMask;
+}
+
+void Max7219::shiftByte(uint8_t value)
+{
+    for (uint8_t bit = 0x80; bit != 0; bit >>= 1)
+    {
+        if (value & bit)
+        {
+            *dinPort |= dinMask;
+        }
+        else
+        {
+            *dinPort &= ~dinMask;
+        }
+        
+        *clkPort |= clkMask;
+        *clkPort &= ~clkMask;
+    }
+}
+
+void Max7219::endFrame()
+{
+    // Data is latched on the rising edge of LOAD
+    *loadPort |= loadMask;
+    SREG = savedSREG;
+}
+
+#endif
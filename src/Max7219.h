@@ -0,0 +1,90 @@
+#ifndef MAX7219_H
+#define MAX7219_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#endif
+
+// Native driver for (cascaded) MAX7219 LED matrix drivers.
+// On the board the pins are driven through their port registers instead of
+// digitalWrite/shiftOut. Building with MAX7219_MOCK (or on a host without
+// ARDUINO) records the shifted byte stream instead, so it can be inspected.
+#if !defined(ARDUINO) && !defined(MAX7219_MOCK)
+#define MAX7219_MOCK
+#endif
+
+namespace Max7219Registers
+{
+    constexpr uint8_t NOOP         = 0x00;
+    constexpr uint8_t DIGIT_0      = 0x01;  // rows are DIGIT_0 .. DIGIT_0 + 7
+    constexpr uint8_t DECODE_MODE  = 0x09;
+    constexpr uint8_t INTENSITY    = 0x0A;
+    constexpr uint8_t SCAN_LIMIT   = 0x0B;
+    constexpr uint8_t SHUTDOWN     = 0x0C;
+    constexpr uint8_t DISPLAY_TEST = 0x0F;
+}
+
+class Max7219
+{
+public:
+    static const uint8_t ROWS = 8;
+    static const uint8_t MAX_DEVICES = 8;
+#ifdef MAX7219_MOCK
+    static const uint16_t MOCK_LOG_SIZE = 256;
+#endif
+
+    Max7219(uint8_t din, uint8_t clk, uint8_t load, uint8_t devices);
+
+    void begin();
+
+    // Single-device register writes (other devices in the chain get NOOP)
+    void writeRegister(uint8_t device, uint8_t reg, uint8_t value);
+    void setShutdown(uint8_t device, bool shutdown);
+    void setIntensity(uint8_t device, uint8_t level);
+    void writeRow(uint8_t device, uint8_t row, uint8_t value);
+    void clear(uint8_t device);
+
+    // Same register on every device, one latch
+    void writeRegisterAll(uint8_t reg, uint8_t value);
+
+    // Batched path: rows[device][row], one latch per row for the whole chain
+    void writeAllRows(const uint8_t rows[][ROWS]);
+
+    uint8_t getDeviceCount() const { return deviceCount; }
+
+#ifdef MAX7219_MOCK
+    // Bytes in shift order; every latch appends 2 * deviceCount bytes
+    const uint8_t* getMockLog() const { return mockLog; }
+    uint16_t getMockLogLength() const { return mockLogLength; }
+    uint16_t getMockLatchCount() const { return mockLatchCount; }
+    void clearMockLog();
+#endif
+
+private:
+    uint8_t dinPin;
+    uint8_t clkPin;
+    uint8_t loadPin;
+    uint8_t deviceCount;
+
+#ifdef MAX7219_MOCK
+    uint8_t mockLog[MOCK_LOG_SIZE];
+    uint16_t mockLogLength;
+    uint16_t mockLatchCount;
+#else
+    volatile uint8_t* dinPort;
+    volatile uint8_t* clkPort;
+    volatile uint8_t* loadPort;
+    uint8_t dinMask;
+    uint8_t clkMask;
+    uint8_t loadMask;
+    uint8_t savedSREG;
+#endif
+
+    void beginFrame();
+    void shiftByte(uint8_t value);
+    void endFrame();
+};
+
+#endif // MAX7219_H
@@ -6,6 +6,7 @@ Player::Player(Map* gameMap)
       goldCollected{0},
       lives{3},
       explosives{0},
+      nearTreasure{false},
       map{gameMap}
 {
 
@@ -16,10 +17,10 @@ bool Player::move(int8_t dx, int8_t dy)
     int16_t newX = x + dx;
     int16_t newY = y + dy;
    
-    if (newX < 0 || newX >= MapConstants::WORLD_SIZE) {
+    if (newX < 0 || newX >= map->getWorldWidth()) {
         return false;  // Out of bounds
     }
-    if (newY < 0 || newY >= MapConstants::WORLD_SIZE) {
+    if (newY < 0 || newY >= map->getWorldHeight()) {
         return false;  // Out of bounds
     }
     
@@ -27,12 +28,16 @@ bool Player::move(int8_t dx, int8_t dy)
     uint8_t targetX = static_cast<uint8_t>(newX);
     uint8_t targetY = static_cast<uint8_t>(newY);
 
+    // Paged worlds: bring the target room in before looking at it
+    map->pageIn(targetX, targetY);
+
     if (!map->isWalkable(targetX, targetY)) {
         return false;  // Wall blocking
     }
     
     x = targetX;
     y = targetY;
+    refreshTreasureProximity();
     
     // After moving, check what we stepped on
     checkAndCollectGold();  // Check for gold
@@ -45,6 +50,8 @@ void Player::setPosition(uint8_t newX, uint8_t newY)
 {
     x = newX;
     y = newY;
+    map->pageIn(x, y);
+    refreshTreasureProximity();
     
     // Check for gold at spawn position
     // (Unlikely, but better safe than sorry)
@@ -86,27 +93,7 @@ bool Player::isOnExit() const
     return (currentTile == TileType::EXIT);
 }
 
-bool Player::isNearHiddenTreasure() const
+void Player::refreshTreasureProximity()
 {
-    for (int8_t dy = -GameplayConstants::TREASURE_DETECTION_RADIUS; dy <= GameplayConstants::TREASURE_DETECTION_RADIUS; dy++)
-    {
-        for (int8_t dx = -GameplayConstants::TREASURE_DETECTION_RADIUS; dx <= GameplayConstants::TREASURE_DETECTION_RADIUS; dx++)
-        {
-            if (dx == 0 && dy == 0) continue;
-            
-            int8_t checkX = x + dx;
-            int8_t checkY = y + dy;
-            
-            if (checkX >= 0 && checkX < MapConstants::WORLD_SIZE &&
-                checkY >= 0 && checkY < MapConstants::WORLD_SIZE)
-            {
-                if (map->getTile(checkX, checkY) == TileType::HIDDEN_GOLD)
-                {
-                    return true;
-                }
-            }
-        }
-    }
-    
-    return false;
+    nearTreasure = map->isNearHiddenGold(x, y);
 }
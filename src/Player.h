@@ -13,6 +13,7 @@ private:
     uint8_t goldCollected;
     uint8_t lives;
     uint8_t explosives;
+    bool nearTreasure;  // cached; refreshed when the player moves or the map changes
     Map* map;
 
 public:
@@ -38,7 +39,8 @@ public:
     bool hasExplosives() const { return explosives > 0; }
     
     bool isOnExit() const;
-    bool isNearHiddenTreasure() const;
+    bool isNearHiddenTreasure() const { return nearTreasure; }
+    void refreshTreasureProximity();
     
 private:
     void checkAndCollectGold();
@@ -0,0 +1,89 @@
+#include "RenderScheduler.h"
+
+RenderScheduler::RenderScheduler(uint8_t targetFps)
+    : frameIntervalMs(0)
+    , lastFrameTime(0)
+    , skipNextFrame(false)
+    , framesRendered(0)
+    , framesSkipped(0)
+    , framesOverrun(0)
+{
+    setTargetFps(targetFps);
+}
+
+void RenderScheduler::setTargetFps(uint8_t fps)
+{
+    if (fps == 0) {
+        fps = 1;
+    }
+    
+    frameIntervalMs = 1000 / fps;
+}
+
+uint8_t RenderScheduler::getTargetFps() const
+{
+    return 1000 / frameIntervalMs;
+}
+
+bool RenderScheduler::isFrameDue(unsigned long currentTime)
+{
+    unsigned long elapsed = currentTime - lastFrameTime;
+    
+    if (elapsed < frameIntervalMs) {
+        return false;
+    }
+    
+    // Long pause (menus, blocking prompts): restart the cadence, nothing was missed
+    if (elapsed >= (unsigned long)frameIntervalMs * DisplayConstants::RENDER_RESYNC_FRAMES) {
+        lastFrameTime = currentTime;
+        skipNextFrame = false;
+        return true;
+    }
+    
+    // Slots that already passed are dropped, not rendered back to back
+    uint8_t missed = 0;
+    while (elapsed >= 2 * (unsigned long)frameIntervalMs) {
+        elapsed -= frameIntervalMs;
+        lastFrameTime += frameIntervalMs;
+        missed++;
+    }
+    lastFrameTime += frameIntervalMs;
+    framesSkipped += missed;
+    
+    if (skipNextFrame) {
+        skipNextFrame = false;
+        framesSkipped++;
+        return false;
+    }
+    
+    return true;
+}
+
+void RenderScheduler::endFrame(unsigned long renderMicros)
+{
+    framesRendered++;
+    
+    if (renderMicros > (unsigned long)frameIntervalMs * 1000UL) {
+        framesOverrun++;
+        skipNextFrame = true;
+    }
+}
+
+void RenderScheduler::resetStats()
+{
+    framesRendered = 0;
+    framesSkipped = 0;
+    framesOverrun = 0;
+}
+
+void RenderScheduler::printDebug() const
+{
+    Serial.print(F("RenderScheduler - Target: "));
+    Serial.print(getTargetFps());
+    Serial.print(F("fps | Rendered: "));
+    Serial.print(framesRendered);
+    Serial.print(F(" | Skipped: "));
+    Serial.print(framesSkipped);
+    Serial.print(F(" | Overrun: "));
+    Serial.println(framesOverrun);
+}
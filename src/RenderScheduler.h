@@ -0,0 +1,40 @@
+#ifndef RENDER_SCHEDULER_H
+#define RENDER_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+// Decides when a matrix frame is due. Late slots are dropped instead of
+// rendered back to back, and a frame that overruns its budget makes the
+// next slot get skipped. Both cases are counted.
+class RenderScheduler
+{
+private:
+    uint16_t frameIntervalMs;
+    unsigned long lastFrameTime;
+    bool skipNextFrame;
+    
+    unsigned long framesRendered;
+    unsigned long framesSkipped;
+    unsigned long framesOverrun;
+
+public:
+    RenderScheduler(uint8_t targetFps = DisplayConstants::TARGET_FPS);
+    
+    void setTargetFps(uint8_t fps);
+    uint8_t getTargetFps() const;
+    uint16_t getFrameIntervalMs() const { return frameIntervalMs; }
+    
+    // True when a frame should be rendered now
+    bool isFrameDue(unsigned long currentTime);
+    // Report how long the frame just rendered took
+    void endFrame(unsigned long renderMicros);
+    
+    unsigned long getFramesRendered() const { return framesRendered; }
+    unsigned long getFramesSkipped() const { return framesSkipped; }
+    unsigned long getFramesOverrun() const { return framesOverrun; }
+    void resetStats();
+    void printDebug() const;
+};
+
+#endif // RENDER_SCHEDULER_H
@@ -1,16 +1,24 @@
 #include <Arduino.h>
-#include <LiquidCrystal.h>
-#include <LedControl.h>
 
 #include "Constants.h"
 #include "Joystick.h"
 #include "MatrixDisplay.h"
+#include "Hd44780.h"
 #include "LCDDisplay.h"
 #include "Buzzer.h"
 #include "PhotoResistor.h"
 #include "GameEngine.h"
 
-LiquidCrystal lcd(
+// 1 = time the native LCD driver against LiquidCrystal at startup (Serial)
+#ifndef LCD_BENCHMARK
+#define LCD_BENCHMARK 0
+#endif
+
+#if LCD_BENCHMARK
+#include <LiquidCrystal.h>
+#endif
+
+Hd44780 lcd(
     LCDPins::RS,
     LCDPins::EN,
     LCDPins::D4,
@@ -29,12 +37,89 @@ GameEngine* gameEngine = nullptr;
 unsigned long startupMessageTime = 0;
 bool waitingForStartup = false;
 
+// Loop profiling (see DebugConstants::PROFILE_LOOP)
+unsigned long lastProfileReport = 0;
+unsigned long loopCount = 0;
+unsigned long loopTimeTotal = 0;
+unsigned long loopTimeMax = 0;
+
+void reportLoopProfile(unsigned long loopTime)
+{
+    loopCount++;
+    loopTimeTotal += loopTime;
+    if (loopTime > loopTimeMax) {
+        loopTimeMax = loopTime;
+    }
+    
+    if (millis() - lastProfileReport < DebugConstants::PROFILE_REPORT_INTERVAL_MS) {
+        return;
+    }
+    lastProfileReport = millis();
+    
+    Serial.print(F("Loop - Avg: "));
+    Serial.print(loopTimeTotal / loopCount);
+    Serial.print(F("us | Max: "));
+    Serial.print(loopTimeMax);
+    Serial.print(F("us | Loops/s: "));
+    Serial.println(loopCount);
+    matrixDisplay.printDebug();
+    lcdDisplay.printDebug();
+    gameEngine->getRenderScheduler().printDebug();
+    
+    loopCount = 0;
+    loopTimeTotal = 0;
+    loopTimeMax = 0;
+    matrixDisplay.resetStats();
+    lcdDisplay.resetStats();
+    gameEngine->getRenderScheduler().resetStats();
+}
+
+#if LCD_BENCHMARK
+// Writes the same characters through both drivers and prints characters per
+// millisecond. Leaves the LCD in an unknown state; re-init it afterwards.
+template <typename Driver>
+unsigned long timeLcdWrites(Driver& driver, uint16_t count)
+{
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < count; i++) {
+        if (i % LCDConstants::COLS == 0) {
+            driver.setCursor(0, (i / LCDConstants::COLS) % LCDConstants::ROWS);
+        }
+        driver.write('A' + i % 26);
+    }
+    return micros() - start;
+}
+
+void runLcdBenchmark()
+{
+    const uint16_t BENCHMARK_CHARS = 320;  // ten full screens
+    
+    unsigned long nativeMicros = timeLcdWrites(lcd, BENCHMARK_CHARS);
+    
+    LiquidCrystal reference(LCDPins::RS, LCDPins::EN, LCDPins::D4, LCDPins::D5, LCDPins::D6, LCDPins::D7);
+    reference.begin(LCDConstants::COLS, LCDConstants::ROWS);
+    unsigned long referenceMicros = timeLcdWrites(reference, BENCHMARK_CHARS);
+    
+    Serial.print(F("LCD benchmark - Hd44780: "));
+    Serial.print(BENCHMARK_CHARS * 1000.0f / nativeMicros);
+    Serial.print(F(" chars/ms | LiquidCrystal: "));
+    Serial.print(BENCHMARK_CHARS * 1000.0f / referenceMicros);
+    Serial.print(F(" chars/ms | Waited on LCD: "));
+    Serial.print(lcd.getWaitMicros());
+    Serial.println(F("us"));
+}
+#endif
+
 void setup()
 {
     Serial.begin(SerialConstants::BAUD_RATE);
     Serial.println(F("The Miner - Starting..."));
 
     lcdDisplay.init();
+#if LCD_BENCHMARK
+    runLcdBenchmark();
+    lcdDisplay.init();
+#endif
     matrixDisplay.begin();
     joystick.init();
     photoResistor.begin();
@@ -63,12 +148,18 @@ void loop()
             gameEngine->begin();
             Serial.println(F("Game started!"));
         }
-        return;
     }
-    
-    if (gameEngine != nullptr)
+    else if (gameEngine != nullptr)
     {
+        unsigned long loopStart = micros();
         gameEngine->update();
+        
+        if (DebugConstants::PROFILE_LOOP) {
+            reportLoopProfile(micros() - loopStart);
+        }
     }
+    
+    // Changed LCD cells go out here, a bounded amount per iteration
+    lcdDisplay.update();
 }
 
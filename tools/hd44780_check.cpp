@@ -0,0 +1,105 @@
+// Power-up stream and ready-at spacing recorded by the HD44780 mock, in
+// simulated microseconds.
+//   g++ -std=c++11 -Isrc -o hd44780_check tools/hd44780_check.cpp src/Hd44780.cpp && ./hd44780_check
+
+#include "Hd44780.h"
+#include "host/check.h"
+
+namespace
+{
+    const unsigned long DATA_EXECUTION_US = 63;
+    const unsigned long CLEAR_EXECUTION_US = 2164;
+
+    const Hd44780::MockTransfer& last(const Hd44780& lcd)
+    {
+        return lcd.getMockLog()[lcd.getMockLogLength() - 1];
+    }
+
+    void checkInit()
+    {
+        Hd44780 lcd(0, 0, 0, 0, 0, 0);
+        lcd.begin();
+
+        const uint8_t expected[] = { 0x30, 0x30, 0x30, 0x20, 0x28, 0x0C, 0x01, 0x06 };
+        const uint16_t count = sizeof(expected) / sizeof(expected[0]);
+        check(lcd.getMockLogLength() == count, "init sends 4 nibbles and 4 commands");
+        for (uint16_t i = 0; i < count && i < lcd.getMockLogLength(); i++)
+        {
+            check(lcd.getMockLog()[i].value == expected[i] && !lcd.getMockLog()[i].isData,
+                  "init stream matches the datasheet sequence");
+        }
+    }
+
+    // Back-to-back data bytes are spaced by the data execution time, and
+    // nothing more
+    void checkDataSpacing()
+    {
+        Hd44780 lcd(0, 0, 0, 0, 0, 0);
+        lcd.begin();
+        lcd.setCursor(0, 0);
+        lcd.clearMockLog();
+
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            lcd.write('A' + i);
+        }
+
+        const Hd44780::MockTransfer* log = lcd.getMockLog();
+        check(lcd.getMockLogLength() == 16, "one transfer per character");
+        for (uint16_t i = 1; i < lcd.getMockLogLength(); i++)
+        {
+            check(log[i].isData, "characters go out as data");
+            check(log[i].at - log[i - 1].at >= DATA_EXECUTION_US, "data bytes are at least 63 us apart");
+            check(log[i].at - log[i - 1].at == DATA_EXECUTION_US, "data bytes wait no longer than needed");
+        }
+    }
+
+    void checkClearWait()
+    {
+        Hd44780 lcd(0, 0, 0, 0, 0, 0);
+        lcd.begin();
+        lcd.clearMockLog();
+
+        unsigned long waitBefore = lcd.getWaitMicros();
+        lcd.clear();
+        lcd.write('X');
+
+        const Hd44780::MockTransfer* log = lcd.getMockLog();
+        check(lcd.getMockLogLength() == 2, "clear then one character");
+        check(log[0].value == Hd44780Commands::CLEAR_DISPLAY && !log[0].isData, "clear is a command");
+        check(log[1].at - log[0].at >= CLEAR_EXECUTION_US, "the byte after CLEAR waits 2.16 ms");
+        check(lcd.getWaitMicros() - waitBefore >= CLEAR_EXECUTION_US, "the CLEAR wait is counted");
+    }
+
+    // Time spent elsewhere between transfers is not waited again
+    void checkIdleCutsWait()
+    {
+        Hd44780 lcd(0, 0, 0, 0, 0, 0);
+        lcd.begin();
+
+        lcd.clear();
+        lcd.advanceMockClock(1000);
+        unsigned long waitBefore = lcd.getWaitMicros();
+        lcd.write('X');
+        check(lcd.getWaitMicros() - waitBefore == CLEAR_EXECUTION_US - 1000,
+              "1 ms of other work cuts the CLEAR wait by 1 ms");
+
+        lcd.advanceMockClock(DATA_EXECUTION_US);
+        check(lcd.isReady(), "ready once the execution time has passed");
+        waitBefore = lcd.getWaitMicros();
+        unsigned long sentAt = lcd.getMockClock();
+        lcd.write('Y');
+        check(lcd.getWaitMicros() == waitBefore, "no wait after the controller is idle");
+        check(last(lcd).at == sentAt, "an idle controller takes the byte immediately");
+    }
+}
+
+int main()
+{
+    checkInit();
+    checkDataSpacing();
+    checkClearWait();
+    checkIdleCutsWait();
+
+    return checkResult("hd44780_check");
+}
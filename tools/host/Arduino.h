@@ -0,0 +1,136 @@
+// Minimal Arduino API for building firmware sources into the host tools
+// (tools/*.cpp). Only what those sources use: PROGMEM reads map to plain
+// memory, outputs and sound do nothing, inputs read what the tool sets
+// (hostPins), Serial prints to stdout, and the clock is a counter the tool
+// advances itself (hostAdvanceMicros).
+//
+// ARDUINO stays undefined, so the display drivers build their mock backends.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t*>(p))
+#define pgm_read_word(p) (*reinterpret_cast<const uint16_t*>(p))
+#define pgm_read_ptr(p) (*reinterpret_cast<void* const*>(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+// Binary literals used by the sources (Arduino's binary.h has them all)
+#define B00000 0x00
+#define B00000000 0x00
+#define B00001 0x01
+#define B00001100 0x0C
+#define B00010 0x02
+#define B00010000 0x10
+#define B00011000 0x18
+#define B00100 0x04
+#define B00100100 0x24
+#define B00111100 0x3C
+#define B01000010 0x42
+#define B01010 0x0A
+#define B01110 0x0E
+#define B01111110 0x7E
+#define B10000 0x10
+#define B10001 0x11
+#define B11011 0x1B
+#define B11100 0x1C
+#define B11111 0x1F
+
+inline unsigned long& hostMicros()
+{
+    static unsigned long now = 0;
+    return now;
+}
+inline void hostAdvanceMicros(unsigned long us) { hostMicros() += us; }
+
+inline unsigned long micros() { return hostMicros(); }
+inline unsigned long millis() { return hostMicros() / 1000; }
+inline void delay(unsigned long ms) { hostAdvanceMicros(ms * 1000); }
+inline void delayMicroseconds(unsigned int us) { hostAdvanceMicros(us); }
+
+// Input levels by pin number: buttons released, analog inputs centred
+struct HostPins
+{
+    static const uint8_t COUNT = 20;
+    int digital[COUNT];
+    int analog[COUNT];
+
+    HostPins()
+    {
+        for (uint8_t pin = 0; pin < COUNT; pin++)
+        {
+            digital[pin] = HIGH;
+            analog[pin] = 512;
+        }
+    }
+};
+inline HostPins& hostPins()
+{
+    static HostPins pins;
+    return pins;
+}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) { return hostPins().digital[pin]; }
+inline int analogRead(uint8_t pin) { return hostPins().analog[pin]; }
+inline void analogWrite(uint8_t, int) {}
+inline void tone(uint8_t, unsigned int, unsigned long = 0) {}
+inline void noTone(uint8_t) {}
+inline long random(long limit) { return limit > 0 ? rand() % limit : 0; }
+inline long random(long low, long high) { return high > low ? low + rand() % (high - low) : low; }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+template <class T> T constrain(T x, T low, T high) { return x < low ? low : (x > high ? high : x); }
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long) {}
+    void print(const char* s) { fputs(s, stdout); }
+    void print(const __FlashStringHelper* s) { fputs(reinterpret_cast<const char*>(s), stdout); }
+    void print(char c) { putchar(c); }
+    void print(int v) { printf("%d", v); }
+    void print(unsigned int v) { printf("%u", v); }
+    void print(long v) { printf("%ld", v); }
+    void print(unsigned long v) { printf("%lu", v); }
+    void print(double v, int digits = 2) { printf("%.*f", digits, v); }
+    template <class T> void println(T v) { print(v); putchar('\n'); }
+    void println() { putchar('\n'); }
+};
+inline HardwareSerial& hostSerial()
+{
+    static HardwareSerial serial;
+    return serial;
+}
+#define Serial hostSerial()
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,30 @@
+// Host stand-in for the Arduino EEPROM library: 1 KB of zeroed RAM, enough
+// for the settings and highscore code to build into host tools.
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+class EEPROMClass
+{
+public:
+    uint8_t read(int address) const { return cells()[address & 0x3FF]; }
+    void write(int address, uint8_t value) { cells()[address & 0x3FF] = value; }
+    void update(int address, uint8_t value) { write(address, value); }
+
+private:
+    static uint8_t* cells()
+    {
+        static uint8_t storage[1024];
+        return storage;
+    }
+};
+inline EEPROMClass& hostEeprom()
+{
+    static EEPROMClass eeprom;
+    return eeprom;
+}
+#define EEPROM hostEeprom()
+
+#endif // HOST_EEPROM_H
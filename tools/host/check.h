@@ -0,0 +1,36 @@
+// Assertion helpers for the host checks in tools/: failed checks are printed
+// and counted, and the program's exit code says whether any failed.
+
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdio.h>
+
+inline int& hostCheckFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", what);
+        hostCheckFailures()++;
+    }
+}
+
+// Return value for main()
+inline int checkResult(const char* name)
+{
+    if (hostCheckFailures() == 0)
+    {
+        printf("%s: all checks passed\n", name);
+        return 0;
+    }
+    printf("%s: %d checks failed\n", name, hostCheckFailures());
+    return 1;
+}
+
+#endif // HOST_CHECK_H
@@ -0,0 +1,166 @@
+// In-game HUD through GameEngine and the LCD mock: layout, that only
+// changed cells go out, and that update() never waits on the LCD. The game
+// is played through its inputs (tools/host pins) and the screen is read
+// back from the transfers the LCD received.
+//   g++ -std=c++11 -Itools/host -Isrc -o hud_check tools/hud_check.cpp src/*.cpp && ./hud_check
+
+#include <cstring>
+
+#include "GameEngine.h"
+#include "host/check.h"
+
+namespace
+{
+    const unsigned long TICK_MS = 10;
+
+    // DDRAM as the transfers in the mock log leave it, glyph codes as '@'
+    struct Screen
+    {
+        char rows[LCDConstants::ROWS][LCDConstants::COLS + 1];
+
+        explicit Screen(const Hd44780& lcd)
+        {
+            std::memset(rows, ' ', sizeof(rows));
+            uint8_t address = 0;
+            bool toDdram = true;
+
+            for (uint16_t i = 0; i < lcd.getMockLogLength(); i++)
+            {
+                const Hd44780::MockTransfer& transfer = lcd.getMockLog()[i];
+                if (transfer.isData)
+                {
+                    uint8_t row = address / Hd44780Commands::ROW_1_OFFSET;
+                    uint8_t col = address % Hd44780Commands::ROW_1_OFFSET;
+                    if (toDdram && row < LCDConstants::ROWS && col < LCDConstants::COLS)
+                    {
+                        char c = transfer.value;
+                        rows[row][col] = (c >= LCDConstants::GLYPH_CODE_BASE && c < LCDConstants::GLYPH_CODE_BASE + 8) ? '@' : c;
+                    }
+                    address++;
+                }
+                else if (transfer.value & Hd44780Commands::SET_DDRAM_ADDR)
+                {
+                    address = transfer.value & ~Hd44780Commands::SET_DDRAM_ADDR;
+                    toDdram = true;
+                }
+                else if (transfer.value & Hd44780Commands::SET_CGRAM_ADDR)
+                {
+                    toDdram = false;
+                }
+            }
+            for (uint8_t row = 0; row < LCDConstants::ROWS; row++)
+            {
+                rows[row][LCDConstants::COLS] = '\0';
+            }
+        }
+    };
+
+    uint16_t countDataTransfers(const Hd44780& lcd)
+    {
+        uint16_t count = 0;
+        for (uint16_t i = 0; i < lcd.getMockLogLength(); i++)
+        {
+            if (lcd.getMockLog()[i].isData)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Main loop iterations over durationMs, as in proiect1.ino
+    void run(GameEngine& game, LCDDisplay& lcdDisplay, Hd44780& lcd, unsigned long durationMs)
+    {
+        for (unsigned long elapsed = 0; elapsed < durationMs; elapsed += TICK_MS)
+        {
+            hostAdvanceMicros(TICK_MS * 1000);
+            lcd.advanceMockClock(TICK_MS * 1000);
+            game.update();
+            lcdDisplay.update();
+        }
+    }
+
+    void pressButton(GameEngine& game, LCDDisplay& lcdDisplay, Hd44780& lcd)
+    {
+        hostPins().digital[JoystickPins::SW_PIN] = LOW;
+        run(game, lcdDisplay, lcd, 100);
+        hostPins().digital[JoystickPins::SW_PIN] = HIGH;
+        run(game, lcdDisplay, lcd, 100);
+    }
+
+    // Held for one game update interval, so the player moves one tile
+    void step(GameEngine& game, LCDDisplay& lcdDisplay, Hd44780& lcd, Pin axis, int reading)
+    {
+        hostPins().analog[axis] = reading;
+        run(game, lcdDisplay, lcd, 200);
+        hostPins().analog[axis] = 512;
+        run(game, lcdDisplay, lcd, 200);
+    }
+
+    // Resends every cell, so the log holds the whole screen
+    Screen readScreen(LCDDisplay& lcdDisplay, Hd44780& lcd)
+    {
+        lcdDisplay.invalidate();
+        lcd.clearMockLog();
+        lcdDisplay.flush();
+        return Screen(lcd);
+    }
+}
+
+int main()
+{
+    Hd44780 lcd(LCDPins::RS, LCDPins::EN, LCDPins::D4, LCDPins::D5, LCDPins::D6, LCDPins::D7);
+    LCDDisplay lcdDisplay(lcd);
+    MatrixDisplay matrixDisplay(MatrixPins::DIN, MatrixPins::CLK, MatrixPins::LOAD);
+    Joystick joystick(JoystickPins::X_PIN, JoystickPins::Y_PIN, JoystickPins::SW_PIN);
+    Buzzer buzzer(BuzzerPins::BUZZER_PIN);
+
+    lcdDisplay.init();
+    GameEngine game(matrixDisplay, lcdDisplay, joystick, buzzer);
+    game.begin();
+
+    // "Start Game" is the first menu entry; let the level banner run out
+    pressButton(game, lcdDisplay, lcd);
+    run(game, lcdDisplay, lcd, 1000);
+
+    Screen hud = readScreen(lcdDisplay, lcd);
+    check(std::strcmp(hud.rows[0], "@ 0/10    @    0") == 0, "row 0 reads \"g cc/tt    *sssss\"");
+    check(std::strcmp(hud.rows[1], "@ 1 @3 @ 0      ") == 0, "row 1 reads \"f ll h l x ee\"");
+
+    // Nothing changed: nothing is sent
+    lcd.clearMockLog();
+    lcdDisplay.resetStats();
+    run(game, lcdDisplay, lcd, 500);
+    check(lcdDisplay.getCellsWritten() == 0 && lcd.getMockLogLength() == 0, "an idle HUD sends nothing");
+
+    // Level 1 has gold at (2, 2), one step down and one right of the spawn.
+    // Gold 0 -> 1 and score 0 -> 10 differ in one cell each.
+    step(game, lcdDisplay, lcd, JoystickPins::Y_PIN, 0);
+    lcd.clearMockLog();
+    lcdDisplay.resetStats();
+    step(game, lcdDisplay, lcd, JoystickPins::X_PIN, 0);
+    lcdDisplay.flush();
+    check(lcdDisplay.getCellsWritten() == 2, "a gold pickup rewrites 2 cells");
+    check(countDataTransfers(lcd) == 2, "a gold pickup sends 2 data bytes");
+    check(lcdDisplay.getGlyphUploads() == 0, "a gold pickup uploads no glyphs");
+
+    hud = readScreen(lcdDisplay, lcd);
+    check(std::strcmp(hud.rows[0], "@ 1/10    @   10") == 0, "row 0 shows the new gold and score");
+
+    // update() leaves cells queued while the LCD is busy instead of waiting
+    lcdDisplay.printAt(0, 1, "Hit by blast!");
+    lcd.clearMockLog();
+    lcd.advanceMockClock(1000);
+    unsigned long waited = lcd.getWaitMicros();
+    lcdDisplay.update();
+    lcdDisplay.update();
+    check(lcd.getWaitMicros() == waited, "update() never waits on the LCD");
+    check(lcd.getMockLogLength() == 1, "update() sends one transfer per ready LCD");
+    lcd.advanceMockClock(1000);
+    lcdDisplay.update();
+    check(lcd.getMockLogLength() == 2 && lcdDisplay.getQueueDepth() > 0, "the rest goes out once the LCD is ready");
+    lcdDisplay.flush();
+    check(lcdDisplay.getQueueDepth() == 0, "flush() waits the queue out");
+
+    return checkResult("hud_check");
+}
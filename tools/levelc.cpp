@@ -0,0 +1,511 @@
+// Level compiler: turns the plain-text levels in levels/ into src/LevelData.h.
+//
+// Build and run on the host (no Arduino headers needed):
+//   g++ -std=c++11 -O2 -o levelc tools/levelc.cpp
+//   ./levelc -o src/LevelData.h levels/level0.txt levels/level1.txt ...
+//
+// Level file format ('#' starts a comment):
+//   spawn X Y           player start tile (default 1 1)
+//   bombs MIN MAX       random bombs at NORMAL difficulty (default 0 0)
+//   explosives N        explosives granted on this level (default 0)
+//   multiplier TENTHS   starting-level score multiplier, 15 = 1.5x (default 10)
+//   flags NAME...       refill_explosives, explosive_bonus
+//   procedural          no map: the firmware generates the layout from the
+//                       level seed (Map::generateLayout)
+//   rooms W H           world size in 8x8 rooms (default 2 2, at most 31 31).
+//                       Worlds larger than 2x2 are paged in by the firmware
+//                       and cannot have random bombs.
+//   map                 followed by H*8 rows of W*8 tiles:
+//                         W wall   . empty   G gold   D door
+//                         X exit   B bomb    H hidden gold
+//
+// Checks: the border is wall or exit, there is an exit, the spawn is an
+// empty tile and the exit can be reached from it without crossing walls,
+// hidden gold or bombs. Walls off the border and room separators (and hidden
+// gold) count as passable only when the player is sure to have explosives on
+// entry: on the first level, or on a level with refill_explosives. Explosives
+// carried over from earlier levels may already be spent.
+//
+// Paged worlds keep every tile change in Map's delta log (DELTA_LOG_SIZE
+// entries) so it survives paging. The most changes a level can see are its
+// gold, hidden gold and bomb tiles plus up to 4 walls per explosive the
+// player can carry into it; LevelData.h gets a static_assert that this fits the log.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int ROOM_SIZE = 8;
+    const int RESIDENT_ROOMS = 2;       // rooms per side kept in RAM by the firmware
+    const int MAX_ROOMS_PER_SIDE = 31;  // MapConstants::MAX_ROOMS_PER_SIDE
+    const int MAX_GROUP_COUNT = 15;
+
+    // Must match TileType in Constants.h
+    enum Tile : uint8_t { EMPTY = 0, WALL = 1, GOLD = 2, DOOR = 3, EXIT = 4, BOMB = 5, HIDDEN_GOLD = 6 };
+
+    const char* const TILE_NAMES[] = { "EMPTY", "WALL", "GOLD", "DOOR", "EXIT", "BOMB", "HIDDEN_GOLD" };
+
+    struct Level
+    {
+        std::string path;
+        int spawnX = 1;
+        int spawnY = 1;
+        int minBombs = 0;
+        int maxBombs = 0;
+        int explosives = 0;
+        int scoreMultTenths = 10;
+        bool procedural = false;
+        int roomsWide = RESIDENT_ROOMS;
+        int roomsHigh = RESIDENT_ROOMS;
+        std::vector<std::string> flags;
+        std::vector<std::vector<uint8_t>> tiles;
+
+        int width() const { return roomsWide * ROOM_SIZE; }
+        int height() const { return roomsHigh * ROOM_SIZE; }
+        bool isPaged() const { return roomsWide > RESIDENT_ROOMS || roomsHigh > RESIDENT_ROOMS; }
+        int goldCount = 0;
+        int hiddenGoldCount = 0;
+        int bombTiles = 0;
+        int blastableWalls = 0;   // walls off every room's outer ring
+        int entryExplosives = 0;  // fewest the player can enter the level with
+        int maxExplosives = 0;    // most the player can carry into the level
+        int maxTileChanges = 0;   // paged worlds: worst case for the delta log
+        std::vector<uint8_t> encoded;
+        std::vector<std::string> lines;  // encoded bytes, formatted for the header
+    };
+
+    [[noreturn]] void fail(const Level& level, int line, const std::string& message)
+    {
+        if (line > 0) {
+            std::fprintf(stderr, "%s:%d: %s\n", level.path.c_str(), line, message.c_str());
+        } else {
+            std::fprintf(stderr, "%s: %s\n", level.path.c_str(), message.c_str());
+        }
+        std::exit(1);
+    }
+
+    bool parseTile(char c, uint8_t& tile)
+    {
+        switch (c) {
+            case 'W': tile = WALL; return true;
+            case '.': tile = EMPTY; return true;
+            case 'G': tile = GOLD; return true;
+            case 'D': tile = DOOR; return true;
+            case 'X': tile = EXIT; return true;
+            case 'B': tile = BOMB; return true;
+            case 'H': tile = HIDDEN_GOLD; return true;
+            default:  return false;
+        }
+    }
+
+    // Same rules as GameEngine::handleExplosion: the outer ring of every room
+    // (border and separators) is indestructible, hidden gold turns into gold.
+    bool isPassable(uint8_t tile, int x, int y, bool canBlast)
+    {
+        if (tile == BOMB) {
+            return false;
+        }
+        if (tile == HIDDEN_GOLD) {
+            return canBlast;
+        }
+        if (tile == WALL) {
+            bool fixed = (x % ROOM_SIZE == 0 || x % ROOM_SIZE == ROOM_SIZE - 1
+                          || y % ROOM_SIZE == 0 || y % ROOM_SIZE == ROOM_SIZE - 1);
+            return canBlast && !fixed;
+        }
+        return true;
+    }
+
+    void parseLevel(Level& level)
+    {
+        std::ifstream in(level.path);
+        if (!in) {
+            fail(level, 0, "cannot open file");
+        }
+
+        std::string raw;
+        int lineNo = 0;
+        int mapRow = -1;  // -1 = directives, 0..15 = reading map rows
+        while (std::getline(in, raw)) {
+            lineNo++;
+            std::string line = raw.substr(0, raw.find('#'));
+            while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r')) {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            if (mapRow >= 0) {
+                if (mapRow >= level.height()) {
+                    fail(level, lineNo, "more map rows than 'rooms' allows");
+                }
+                if (static_cast<int>(line.size()) != level.width()) {
+                    fail(level, lineNo, "map row must be exactly " + std::to_string(level.width()) + " tiles");
+                }
+                for (int x = 0; x < level.width(); x++) {
+                    if (!parseTile(line[x], level.tiles[mapRow][x])) {
+                        fail(level, lineNo, std::string("unknown tile '") + line[x] + "'");
+                    }
+                }
+                mapRow++;
+                continue;
+            }
+
+            std::istringstream words(line);
+            std::string key;
+            words >> key;
+            bool ok = true;
+            if (key == "spawn") {
+                ok = static_cast<bool>(words >> level.spawnX >> level.spawnY);
+            } else if (key == "bombs") {
+                ok = static_cast<bool>(words >> level.minBombs >> level.maxBombs);
+            } else if (key == "explosives") {
+                ok = static_cast<bool>(words >> level.explosives);
+            } else if (key == "multiplier") {
+                ok = static_cast<bool>(words >> level.scoreMultTenths);
+            } else if (key == "flags") {
+                std::string flag;
+                while (words >> flag) {
+                    if (flag != "refill_explosives" && flag != "explosive_bonus") {
+                        fail(level, lineNo, "unknown flag '" + flag + "'");
+                    }
+                    level.flags.push_back(flag);
+                }
+            } else if (key == "rooms") {
+                ok = static_cast<bool>(words >> level.roomsWide >> level.roomsHigh);
+                if (ok && (level.roomsWide < RESIDENT_ROOMS || level.roomsHigh < RESIDENT_ROOMS
+                           || level.roomsWide > MAX_ROOMS_PER_SIDE || level.roomsHigh > MAX_ROOMS_PER_SIDE)) {
+                    fail(level, lineNo, "rooms must be between 2 and 31 per side");
+                }
+            } else if (key == "procedural") {
+                level.procedural = true;
+            } else if (key == "map") {
+                if (level.procedural) {
+                    fail(level, lineNo, "procedural levels have no map");
+                }
+                level.tiles.assign(level.height(), std::vector<uint8_t>(level.width(), EMPTY));
+                mapRow = 0;
+            } else {
+                fail(level, lineNo, "unknown directive '" + key + "'");
+            }
+            if (!ok) {
+                fail(level, lineNo, "bad arguments for '" + key + "'");
+            }
+        }
+
+        if (!level.procedural && mapRow != level.height()) {
+            fail(level, 0, "expected 'map' followed by " + std::to_string(level.height()) + " rows");
+        }
+        if (level.procedural && level.isPaged()) {
+            fail(level, 0, "procedural levels are 2x2 rooms");
+        }
+        if (level.isPaged() && level.maxBombs > 0) {
+            fail(level, 0, "paged worlds (more than 2x2 rooms) cannot have random bombs");
+        }
+        if (level.minBombs < 0 || level.maxBombs < level.minBombs || level.maxBombs > 255) {
+            fail(level, 0, "bombs must satisfy 0 <= MIN <= MAX <= 255");
+        }
+        if (level.explosives < 0 || level.explosives > 255 || level.scoreMultTenths <= 0 || level.scoreMultTenths > 255) {
+            fail(level, 0, "explosives/multiplier out of range");
+        }
+    }
+
+    void validateLevel(Level& level)
+    {
+        int exits = 0;
+        for (int y = 0; y < level.height(); y++) {
+            for (int x = 0; x < level.width(); x++) {
+                uint8_t tile = level.tiles[y][x];
+                bool border = (x == 0 || y == 0 || x == level.width() - 1 || y == level.height() - 1);
+                if (border && tile != WALL && tile != EXIT) {
+                    char message[64];
+                    std::snprintf(message, sizeof(message), "border tile (%d, %d) must be W or X", x, y);
+                    fail(level, 0, message);
+                }
+                if (tile == EXIT) exits++;
+                if (tile == GOLD) level.goldCount++;
+                if (tile == HIDDEN_GOLD) level.hiddenGoldCount++;
+                if (tile == BOMB) level.bombTiles++;
+                if (tile == WALL && isPassable(tile, x, y, true)) level.blastableWalls++;
+            }
+        }
+        if (exits == 0) {
+            fail(level, 0, "level has no exit");
+        }
+        if (level.spawnX < 0 || level.spawnY < 0 || level.spawnX >= level.width() || level.spawnY >= level.height()
+            || level.tiles[level.spawnY][level.spawnX] != EMPTY) {
+            fail(level, 0, "spawn must be an empty tile inside the map");
+        }
+        if (level.goldCount > 255 || level.hiddenGoldCount > 255) {
+            fail(level, 0, "too much gold");
+        }
+
+        // Flood fill from the spawn over tiles the player can cross safely
+        bool canBlast = level.entryExplosives > 0;
+        std::vector<std::vector<bool>> seen(level.height(), std::vector<bool>(level.width(), false));
+        std::vector<int> stack(1, level.spawnY * level.width() + level.spawnX);
+        seen[level.spawnY][level.spawnX] = true;
+        bool exitReached = false;
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            int x = cell % level.width();
+            int y = cell / level.width();
+            if (level.tiles[y][x] == EXIT) {
+                exitReached = true;
+            }
+            const int dx[] = { 1, -1, 0, 0 };
+            const int dy[] = { 0, 0, 1, -1 };
+            for (int i = 0; i < 4; i++) {
+                int nx = x + dx[i];
+                int ny = y + dy[i];
+                if (nx < 0 || ny < 0 || nx >= level.width() || ny >= level.height() || seen[ny][nx]) {
+                    continue;
+                }
+                if (!isPassable(level.tiles[ny][nx], nx, ny, canBlast)) {
+                    continue;
+                }
+                seen[ny][nx] = true;
+                stack.push_back(ny * level.width() + nx);
+            }
+        }
+        if (!exitReached) {
+            fail(level, 0, "exit is not reachable from the spawn");
+        }
+    }
+
+    // Explosives carry over between levels unless the next one refills them,
+    // and a game can start on any level with that level's own count. Only
+    // the first level is never entered from another one.
+    void computeExplosives(std::vector<Level>& levels)
+    {
+        int carried = 0;
+        for (size_t i = 0; i < levels.size(); i++) {
+            Level& level = levels[i];
+            bool refill = std::find(level.flags.begin(), level.flags.end(), "refill_explosives") != level.flags.end();
+            level.entryExplosives = (i == 0 || refill) ? level.explosives : 0;
+            level.maxExplosives = refill ? level.explosives : std::max(level.explosives, carried);
+            carried = level.maxExplosives;
+        }
+    }
+
+    void computeTileChanges(std::vector<Level>& levels)
+    {
+        const int WALLS_PER_EXPLOSION = 4;  // the blast cross minus the tile it was placed on
+
+        for (Level& level : levels) {
+            if (level.isPaged()) {
+                level.maxTileChanges = level.goldCount + level.hiddenGoldCount + level.bombTiles
+                                     + std::min(level.blastableWalls, WALLS_PER_EXPLOSION * level.maxExplosives);
+            }
+        }
+    }
+
+    std::string hexByte(int value)
+    {
+        char text[8];
+        std::snprintf(text, sizeof(text), "0x%02X", value & 0xFF);
+        return text;
+    }
+
+    // LevelFormat: a 16-bit offset per room, then per room 8 wall rows, one
+    // group per tile type (split at 15 positions) and ROOM_END.
+    void encodeLevel(Level& level)
+    {
+        const int roomCount = level.roomsWide * level.roomsHigh;
+        std::vector<int> offsets;
+        std::vector<uint8_t> records;
+        std::vector<std::string> recordLines;
+
+        for (int room = 0; room < roomCount; room++) {
+            int originX = (room % level.roomsWide) * ROOM_SIZE;
+            int originY = (room / level.roomsWide) * ROOM_SIZE;
+            offsets.push_back(roomCount * 2 + static_cast<int>(records.size()));
+
+            recordLines.push_back("// Room " + std::to_string(room));
+            std::string walls;
+            for (int row = 0; row < ROOM_SIZE; row++) {
+                uint8_t bits = 0;
+                for (int col = 0; col < ROOM_SIZE; col++) {
+                    if (level.tiles[originY + row][originX + col] == WALL) {
+                        bits |= 0x80 >> col;
+                    }
+                }
+                records.push_back(bits);
+                walls += hexByte(bits) + ", ";
+            }
+            walls.pop_back();
+            recordLines.push_back(walls);
+
+            for (int type = GOLD; type <= HIDDEN_GOLD; type++) {
+                std::vector<uint8_t> positions;
+                for (int row = 0; row < ROOM_SIZE; row++) {
+                    for (int col = 0; col < ROOM_SIZE; col++) {
+                        if (level.tiles[originY + row][originX + col] == type) {
+                            positions.push_back(static_cast<uint8_t>(row << 3 | col));
+                        }
+                    }
+                }
+                for (size_t first = 0; first < positions.size(); first += MAX_GROUP_COUNT) {
+                    size_t count = std::min(positions.size() - first, static_cast<size_t>(MAX_GROUP_COUNT));
+                    records.push_back(static_cast<uint8_t>(type << 4 | count));
+                    std::string text = std::string("LevelFormat::group(TileType::") + TILE_NAMES[type] + ", " + std::to_string(count) + "),";
+                    for (size_t i = first; i < first + count; i++) {
+                        records.push_back(positions[i]);
+                        text += " " + hexByte(positions[i]) + ",";
+                    }
+                    recordLines.push_back(text);
+                }
+            }
+
+            records.push_back(0x00);
+            recordLines.push_back("LevelFormat::ROOM_END,");
+        }
+
+        if (offsets.back() > 0xFFFF) {
+            fail(level, 0, "layout larger than 64 KB");
+        }
+        level.lines.push_back("// Room offsets");
+        std::string table;
+        for (int offset : offsets) {
+            level.encoded.push_back(static_cast<uint8_t>(offset & 0xFF));
+            level.encoded.push_back(static_cast<uint8_t>(offset >> 8));
+            table += hexByte(offset & 0xFF) + ", " + hexByte(offset >> 8) + ", ";
+            if (table.size() > 90) {
+                table.pop_back();
+                level.lines.push_back(table);
+                table.clear();
+            }
+        }
+        if (!table.empty()) {
+            table.pop_back();
+            level.lines.push_back(table);
+        }
+        level.encoded.insert(level.encoded.end(), records.begin(), records.end());
+        level.lines.insert(level.lines.end(), recordLines.begin(), recordLines.end());
+    }
+
+    std::string flagsExpression(const Level& level)
+    {
+        std::string text;
+        for (size_t i = 0; i < level.flags.size(); i++) {
+            if (!text.empty()) text += " | ";
+            text += level.flags[i] == "refill_explosives" ? "LevelFlags::REFILL_EXPLOSIVES" : "LevelFlags::EXPLOSIVE_BONUS";
+        }
+        if (level.procedural) {
+            if (!text.empty()) text += " | ";
+            text += "LevelFlags::PROCEDURAL";
+        }
+        return text.empty() ? "LevelFlags::NONE" : text;
+    }
+
+    void writeHeader(FILE* out, const std::vector<Level>& levels)
+    {
+        std::fprintf(out, "// Generated by tools/levelc.cpp from levels/*.txt. Do not edit by hand.\n\n");
+        std::fprintf(out, "#ifndef LEVEL_DATA_H\n#define LEVEL_DATA_H\n\n");
+        std::fprintf(out, "#include <Arduino.h>\n#include \"Constants.h\"\n#include \"Levels.h\"\n\n");
+        std::fprintf(out, "// Encoded level layouts (see LevelFormat in Constants.h).\n");
+        std::fprintf(out, "// A table of room offsets, then the rooms in row-major order.\n");
+        std::fprintf(out, "// Each room: 8 wall rows, then feature groups, then ROOM_END.\n\n");
+        std::fprintf(out, "#define LEVEL_DATA_COUNT %zu\n", levels.size());
+
+        for (size_t i = 0; i < levels.size(); i++) {
+            const Level& level = levels[i];
+            if (level.procedural) {
+                continue;
+            }
+            std::fprintf(out, "\n// %s: %dx%d rooms, %zu bytes, %d gold, %d hidden gold\n",
+                         level.path.c_str(), level.roomsWide, level.roomsHigh, level.encoded.size(),
+                         level.goldCount, level.hiddenGoldCount);
+            std::fprintf(out, "const uint8_t LEVEL_%zu_DATA[] PROGMEM = {\n", i);
+            for (const std::string& line : level.lines) {
+                std::fprintf(out, "    %s\n", line.c_str());
+            }
+            std::fprintf(out, "};\n");
+            if (level.isPaged()) {
+                std::fprintf(out, "static_assert(%d <= MapConstants::DELTA_LOG_SIZE, \"%s can change %d tiles, more than Map's delta log holds\");\n",
+                             level.maxTileChanges, level.path.c_str(), level.maxTileChanges);
+            }
+        }
+
+        std::fprintf(out, "\nconst LevelDescriptor LEVELS[MapConstants::LEVEL_COUNT] PROGMEM = {\n");
+        std::fprintf(out, "    // layout, rooms wide/high, spawn x/y, min/max bombs, explosives, score multiplier (x10), flags, gold, hidden gold\n");
+        for (size_t i = 0; i < levels.size(); i++) {
+            const Level& level = levels[i];
+            std::string layout = level.procedural ? "nullptr" : "LEVEL_" + std::to_string(i) + "_DATA";
+            std::fprintf(out, "    { %s, %d, %d, %d, %d, %d, %d, %d, %d, %s, %d, %d },\n",
+                         layout.c_str(), level.roomsWide, level.roomsHigh, level.spawnX, level.spawnY, level.minBombs, level.maxBombs, level.explosives,
+                         level.scoreMultTenths, flagsExpression(level).c_str(), level.goldCount, level.hiddenGoldCount);
+        }
+        std::fprintf(out, "};\n\n#endif // LEVEL_DATA_H\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* outputPath = nullptr;
+    std::vector<Level> levels;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            Level level;
+            level.path = arg;
+            levels.push_back(level);
+        }
+    }
+    if (!outputPath || levels.empty()) {
+        std::fprintf(stderr, "usage: %s -o LevelData.h level0.txt [level1.txt ...]\n", argv[0]);
+        return 2;
+    }
+
+    for (Level& level : levels) {
+        parseLevel(level);
+    }
+    computeExplosives(levels);
+
+    size_t totalBytes = 0;
+    for (Level& level : levels) {
+        if (level.procedural) {
+            continue;
+        }
+        validateLevel(level);
+        encodeLevel(level);
+        totalBytes += level.encoded.size();
+    }
+    computeTileChanges(levels);
+
+    for (const Level& level : levels) {
+        if (level.procedural) {
+            std::printf("%-24s procedural        bombs %d-%d\n", level.path.c_str(), level.minBombs, level.maxBombs);
+            continue;
+        }
+        std::printf("%-24s %dx%d %4zu bytes  gold %2d  hidden %2d  bombs %d-%d", level.path.c_str(),
+                    level.roomsWide, level.roomsHigh, level.encoded.size(), level.goldCount, level.hiddenGoldCount, level.minBombs, level.maxBombs);
+        if (level.isPaged()) {
+            std::printf("  tile changes <= %d", level.maxTileChanges);
+        }
+        std::printf("\n");
+    }
+
+    FILE* out = std::fopen(outputPath, "w");
+    if (!out) {
+        std::fprintf(stderr, "%s: cannot write\n", outputPath);
+        return 1;
+    }
+    writeHeader(out, levels);
+    std::fclose(out);
+
+    std::printf("%zu levels, %zu bytes of layout data -> %s\n", levels.size(), totalBytes, outputPath);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Host microbenchmark for Map tile storage: times getTile() over a loaded
+// level and reports sizeof(Map), so the packed (4-bit) and byte-per-tile
+// layouts can be compared.
+//
+// Build and run on the host, once per layout:
+//   g++ -std=c++11 -O2 -Itools/host -Isrc -o map_bench tools/map_bench.cpp src/Map.cpp src/Levels.cpp src/GameSettings.cpp && ./map_bench
+//   g++ -std=c++11 -O2 -Itools/host -Isrc -DMAP_PACKED_TILES=0 -o map_bench tools/map_bench.cpp src/Map.cpp src/Levels.cpp src/GameSettings.cpp && ./map_bench
+//
+// Absolute numbers are host numbers; only the ratio between the two builds
+// says anything about the AVR.
+
+#include <chrono>
+#include <cstdio>
+
+#include "Map.h"
+
+namespace
+{
+    const uint8_t BENCH_LEVEL = 3;
+    const unsigned long PASSES = 200000;   // 51M calls per round on a 16x16 level
+    const uint8_t ROUNDS = 5;
+}
+
+int main()
+{
+    Map map;
+    map.loadLevel(BENCH_LEVEL, nullptr);
+
+    const uint8_t width = map.getWorldWidth();
+    const uint8_t height = map.getWorldHeight();
+
+    // Fastest of several rounds, to keep scheduler noise out; the sum keeps
+    // the compiler from dropping the loop
+    unsigned long checksum = 0;
+    double bestNs = 0;
+    for (uint8_t round = 0; round < ROUNDS; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long pass = 0; pass < PASSES; pass++)
+        {
+            for (uint8_t y = 0; y < height; y++)
+            {
+                for (uint8_t x = 0; x < width; x++)
+                {
+                    checksum += static_cast<uint8_t>(map.getTile(x, y));
+                }
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (round == 0 || ns < bestNs)
+        {
+            bestNs = ns;
+        }
+    }
+
+    double calls = static_cast<double>(PASSES) * width * height;
+
+    std::printf("MAP_PACKED_TILES=%d  sizeof(Map)=%u  getTile: %.0fM calls, %.2f ns/call (checksum %lu)\n",
+                MAP_PACKED_TILES, static_cast<unsigned>(sizeof(Map)), calls / 1e6, bestNs / calls, checksum);
+    return 0;
+}
@@ -0,0 +1,91 @@
+// NOOP padding and latch counts of the MAX7219 mock's shifted bytes.
+//   g++ -std=c++11 -Isrc -o max7219_check tools/max7219_check.cpp src/Max7219.cpp && ./max7219_check
+
+#include "Max7219.h"
+#include "host/check.h"
+
+namespace
+{
+    // A single-device write pads every other device with NOOP 0x00, and the
+    // last device in the chain is shifted first
+    void checkSingleDeviceWrite()
+    {
+        const uint8_t devices = 4;
+        Max7219 chain(0, 0, 0, devices);
+
+        for (uint8_t target = 0; target < devices; target++)
+        {
+            chain.clearMockLog();
+            chain.writeRow(target, 3, 0xA5);
+
+            const uint8_t* log = chain.getMockLog();
+            check(chain.getMockLatchCount() == 1, "single write latches once");
+            check(chain.getMockLogLength() == 2 * devices, "single write shifts 2 bytes per device");
+
+            for (uint8_t slot = 0; slot < devices; slot++)
+            {
+                uint8_t device = devices - 1 - slot;
+                uint8_t reg = log[2 * slot];
+                uint8_t value = log[2 * slot + 1];
+                if (device == target)
+                {
+                    check(reg == Max7219Registers::DIGIT_0 + 3 && value == 0xA5,
+                          "target device gets its row register and value");
+                }
+                else
+                {
+                    check(reg == Max7219Registers::NOOP && value == 0,
+                          "other devices get NOOP padding");
+                }
+            }
+        }
+
+        chain.clearMockLog();
+        chain.writeRow(devices, 0, 0xFF);
+        check(chain.getMockLogLength() == 0 && chain.getMockLatchCount() == 0,
+              "write to a device past the chain is dropped");
+    }
+
+    // The batched path latches once per row for the whole chain
+    void checkWriteAllRows()
+    {
+        const uint8_t devices = 3;
+        Max7219 chain(0, 0, 0, devices);
+
+        uint8_t rows[devices][Max7219::ROWS];
+        for (uint8_t device = 0; device < devices; device++)
+        {
+            for (uint8_t row = 0; row < Max7219::ROWS; row++)
+            {
+                rows[device][row] = static_cast<uint8_t>(device << 4 | row);
+            }
+        }
+
+        chain.clearMockLog();
+        chain.writeAllRows(rows);
+
+        const uint8_t* log = chain.getMockLog();
+        check(chain.getMockLatchCount() == Max7219::ROWS, "writeAllRows latches once per row");
+        check(chain.getMockLogLength() == Max7219::ROWS * 2 * devices,
+              "writeAllRows shifts 2 bytes per device per row");
+
+        for (uint8_t row = 0; row < Max7219::ROWS; row++)
+        {
+            for (uint8_t slot = 0; slot < devices; slot++)
+            {
+                uint8_t device = devices - 1 - slot;
+                const uint8_t* pair = log + (row * devices + slot) * 2;
+                check(pair[0] == Max7219Registers::DIGIT_0 + row, "row frame addresses the same row on every device");
+                check(pair[1] == rows[device][row], "row frame carries each device's own byte");
+            }
+        }
+    }
+}
+
+int main()
+{
+    checkSingleDeviceWrite();
+    checkWriteAllRows();
+
+    return checkResult("max7219_check");
+}